@@ -31,7 +31,25 @@
 /// Define if nesting interrupt is active
 //#define NESTING_INT 0
 
+/// Define if tasks can share a priority
+/// Tasks with the same priority run in round-robin, TIME_SLICE_TICKS each
+#define ROUND_ROBIN_EN 		0
+#define TIME_SLICE_TICKS 		10
+
+/// Define if the scheduler can be locked (OSSchedLock / OSSchedUnlock)
+/// Interrupts stay enabled while the lock is held, only the context switches are deferred
+#define BRTOS_SCHED_LOCK_EN 	0
+
+/// Define if tasks can be deleted (OSTaskDelete)
+/// The stacks of the deleted tasks are reused by the next installed tasks
+#define TASK_DELETE_EN 		0
+
+/// Define if the stack use of the tasks is measured (OSTaskStackHighWater)
+/// The stacks are painted at task install and verified by the idle task
+#define STACK_WATERMARK_EN 	0
+
 /// Define Number of Priorities
+/// 8, 16 or 32. Above 32 a two-level bitmap is used (multiples of 32, up to 256)
 #define NUMBER_OF_PRIORITIES 	32
 
 /// Define the maximum number of Tasks to be Installed
@@ -51,12 +69,20 @@
   #include "debug_stack.h"
 #endif
 
+/// Define if the tick counter, delays and timeouts use 32 bits
+/// Long delays need a single wake up. Otherwise the tick count overflows at 64000
+#define TICK_COUNT_32BITS 0
+
 /// Define if TimerHook function is active
 #define TIMER_HOOK_EN 0
 
 /// Define if IdleHook function is active
 #define IDLE_HOOK_EN 0
 
+/// Define if the tickless idle mode is active
+/// The tick interrupts are suppressed while the system is idle (the port must support it)
+#define TICKLESS_IDLE_EN 0
+
 /// Enable or disable timers service
 #define BRTOS_TMR_EN           1
 
@@ -69,6 +95,12 @@
 /// Enable or disable mutex controls
 #define BRTOS_MUTEX_EN         1
 
+/// Enable or disable priority inheritance mutexes - OSMutexCreate(&mutex, MUTEX_INHERIT)
+#define BRTOS_MUTEX_INHERIT_EN 0
+
+/// Enable or disable recursive mutexes - OSMutexCreateRecursive(&mutex, priority)
+#define BRTOS_MUTEX_RECURSIVE_EN 0
+
 /// Enable or disable mailbox controls
 #define BRTOS_MBOX_EN          1
 
@@ -78,6 +110,50 @@
 /// Enable or disable dynamic queue controls
 #define BRTOS_DYNAMIC_QUEUE_ENABLED	1
 
+/// Enable or disable fixed-block memory pool controls
+#define BRTOS_MEMPOOL_EN       0
+
+/// Allocate the dynamic queues from the memory pools instead of BRTOS_ALLOC
+#define BRTOS_DQUEUE_MEMPOOL_EN	0
+
+/// Enable or disable task notifications (OSTaskNotify / OSTaskNotifyWait)
+#define TASK_NOTIFY_EN         0
+
+/// Enable or disable event flags controls
+#define BRTOS_FLAG_EN          0
+
+/// Enable or disable single producer / single consumer stream buffers
+#define BRTOS_STREAM_EN        0
+
+/// Enable or disable the blocking queue and mailbox posts (OSQueuePostWait, OSDQueuePostWait, OSMboxPostWait)
+#define BRTOS_POST_WAIT_EN     0
+
+/// Enable or disable the dynamic queue zero-copy slots (OSDQueueReserve / OSDQueueCommit, OSDQueuePeekSlot / OSDQueueRelease)
+#define BRTOS_DQUEUE_SLOT_EN   0
+
+/// Enable or disable reader-writer locks
+#define BRTOS_RWLOCK_EN        0
+
+/// Enable or disable condition variables (used with the mutexes)
+#define BRTOS_COND_EN          0
+
+/// Enable or disable barriers
+#define BRTOS_BARRIER_EN       0
+
+/// Enable or disable deferred calls - interrupt work run by a kernel task
+#define BRTOS_DEFER_EN         0
+
+/// Enable or disable the work queue - pool of worker tasks (uses semaphores and dynamic queues)
+#define BRTOS_WORK_EN          0
+
+/// Enable or disable the shared object pool\n
+/// Semaphores, mutexes, mailboxes and queues use BRTOS_MAX_OBJECTS control blocks
+/// instead of BRTOS_MAX_SEM, BRTOS_MAX_MUTEX, BRTOS_MAX_MBOX and BRTOS_MAX_QUEUE
+#define BRTOS_OBJECT_POOL_EN   0
+
+/// Enable or disable event sets - wait on several semaphores, mailboxes and queues at once
+#define BRTOS_SET_EN           0
+
 /// Enable or disable queue 16 bits controls
 #define BRTOS_QUEUE_16_EN      0
 
@@ -100,6 +176,45 @@
 /// Limits the memory allocation for queues
 #define BRTOS_MAX_QUEUE        20
 
+/// Defines the maximum number of memory pools\n
+/// Limits the memory allocation for memory pools
+#define BRTOS_MAX_MEMPOOL      4
+
+/// Defines the maximum number of event flag groups\n
+/// Limits the memory allocation for event flags
+#define BRTOS_MAX_FLAG         4
+
+/// Defines the maximum number of stream buffers\n
+/// Limits the memory allocation for stream buffers
+#define BRTOS_MAX_STREAM       2
+
+/// Defines the maximum number of event sets\n
+/// Limits the memory allocation for event sets
+#define BRTOS_MAX_SET          2
+
+/// Defines the maximum number of reader-writer locks\n
+/// Limits the memory allocation for reader-writer locks
+#define BRTOS_MAX_RWLOCK       2
+
+/// Defines the maximum number of condition variables\n
+/// Limits the memory allocation for condition variables
+#define BRTOS_MAX_COND         2
+
+/// Defines the maximum number of barriers\n
+/// Limits the memory allocation for barriers
+#define BRTOS_MAX_BARRIER      2
+
+/// Defines the number of pending deferred calls (up to 255)\n
+/// Limits the memory allocation for deferred calls
+#define BRTOS_DEFER_SIZE       8
+
+/// Defines the number of pending work queue jobs (up to 255)\n
+/// Limits the memory allocation for work queue jobs
+#define BRTOS_WORK_QUEUE_SIZE  8
+
+/// Defines the number of control blocks of the shared object pool (up to 255)
+#define BRTOS_MAX_OBJECTS      16
+
 
 /// TickTimer Defines
 #define configCPU_CLOCK_HZ          	(INT32U)168000000   ///< CPU clock in Hertz
@@ -107,7 +107,12 @@ sys_mbox_free(sys_mbox_t mbox)
 void
 sys_mbox_post(sys_mbox_t mbox, void *data)
 {
+#if (BRTOS_POST_WAIT_EN == 1)
+	// Waits for space in the mailbox instead of dropping the message
+	(void)OSDQueuePostWait(mbox, &data, 0);
+#else
 	(void)OSDQueuePost(mbox, &data);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------*/
@@ -150,7 +155,7 @@ sys_mbox_trypost( sys_mbox_t mbox, void *data )
 u32_t sys_arch_mbox_fetch(sys_mbox_t mbox, void **msg, u32_t timeout)
 {
 void *dummyptr;
-INT16U StartTime, EndTime, Elapsed;
+TickType StartTime, EndTime, Elapsed;
 
 	StartTime = OSGetTickCount();
 
@@ -243,7 +248,7 @@ sys_sem_new(u8_t count)
 u32_t
 sys_arch_sem_wait(sys_sem_t sem, u32_t timeout)
 {
-	INT16U StartTime, EndTime, Elapsed;
+	TickType StartTime, EndTime, Elapsed;
 
 	StartTime = OSGetTickCount();
 
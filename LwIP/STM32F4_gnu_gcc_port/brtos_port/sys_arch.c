@@ -108,7 +108,12 @@ sys_mbox_free(sys_mbox_t mbox)
 void
 sys_mbox_post(sys_mbox_t mbox, void *data)
 {
+#if (BRTOS_POST_WAIT_EN == 1)
+	// Waits for space in the mailbox instead of dropping the message
+	(void)OSDQueuePostWait(mbox, &data, 0);
+#else
 	(void)OSDQueuePost(mbox, &data);
+#endif
 }
 
 /*-----------------------------------------------------------------------------------*/
@@ -151,7 +156,7 @@ sys_mbox_trypost( sys_mbox_t mbox, void *data )
 u32_t sys_arch_mbox_fetch(sys_mbox_t mbox, void **msg, u32_t timeout)
 {
 void *dummyptr;
-INT16U StartTime, EndTime, Elapsed;
+TickType StartTime, EndTime, Elapsed;
 
 	StartTime = OSGetTickCount();
 
@@ -244,7 +249,7 @@ sys_sem_new(u8_t count)
 u32_t
 sys_arch_sem_wait(sys_sem_t sem, u32_t timeout)
 {
-	INT16U StartTime, EndTime, Elapsed;
+	TickType StartTime, EndTime, Elapsed;
 
 	StartTime = OSGetTickCount();
 
@@ -405,8 +410,14 @@ sys_thread_new(char *name, void ( *thread ) ( void *arg ), void *arg, int stacks
      * tasks gets scheduled inside the xTaskCreate function. To prevent this we
      * disable the scheduling. Note that this can happen although we have interrupts
      * disabled because xTaskCreate contains a call to taskYIELD( ).
+     * With the scheduler lock the interrupts stay enabled during the allocation
+     * and the task installation.
      */
+#if (BRTOS_SCHED_LOCK_EN == 1)
+    (void)OSSchedLock( );
+#else
     UserEnterCritical( );
+#endif
 
     p = tasks;
     i = 0;
@@ -457,7 +468,11 @@ sys_thread_new(char *name, void ( *thread ) ( void *arg ), void *arg, int stacks
         }
     }
 
+#if (BRTOS_SCHED_LOCK_EN == 1)
+    (void)OSSchedUnlock( );
+#else
     UserExitCritical( );
+#endif
     return thread_hdl;
 }
 /*
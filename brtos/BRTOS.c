@@ -95,6 +95,14 @@ CHAR8 BufferText[TEXT_BUFFER_SIZE];
 #endif
                      
 INT8U PriorityVector[configMAX_TASK_INSTALL];   ///< Allocate task priorities
+
+#if (ROUND_ROBIN_EN == 1)
+INT8U OSReadyHead[configMAX_TASK_INSTALL];            ///< First task of the ready FIFO of each priority - 0 if empty
+INT8U OSReadyTail[configMAX_TASK_INSTALL];            ///< Last task of the ready FIFO of each priority
+INT8U PriorityTasks[configMAX_TASK_INSTALL];          ///< Number of tasks installed with each priority
+INT16U OSWaitOrder = 0;                               ///< Arrival counter of the event wait lists
+INT16U OSTimeSliceCnt = 0;                            ///< Ticks consumed by the current task time slice
+#endif
 INT16U iStackAddress = 0;                       ///< Virtual stack counter - Informs the stack occupation in bytes
 
 
@@ -108,6 +116,28 @@ INT32U StackAddress = (INT32U)&STACK;           ///< Virtual stack pointer
 INT16U StackAddress = (INT16U)&STACK;           ///< Virtual stack pointer
 #endif
 
+#if (TASK_DELETE_EN == 1)
+BRTOS_StackFree OSStackFreeList[NUMBER_OF_TASKS + 1];  ///< Stack regions released by OSTaskDelete
+
+#define STACK_FREE_NONE         (INT8U)0xFF
+
+static INT8U  OSStackFreeSearch(INT16U Words);
+static INT16U OSStackFreeTake(INT8U Entry, INT16U Words);
+
+#if (SP_SIZE == 32)
+#define STACK_ADDRESS(index)    (INT32U)&STACK[index]
+#else
+#define STACK_ADDRESS(index)    (INT16U)&STACK[index]
+#endif
+#endif
+
+#if (STACK_WATERMARK_EN == 1)
+INT8U  OSWatermarkTask = 1;                       ///< Task whose stack is being verified
+INT16U OSWatermarkCursor = 0;                     ///< Next stack word to verify, from the stack end
+
+static void OSStackPaint(ContextType *Task);
+#endif
+
 
 
 // global variables
@@ -116,6 +146,10 @@ INT8U NumberOfInstalledTasks;                 ///< Number of Installed tasks at
 volatile INT8U currentTask;                            ///< Current task being executed
 volatile INT8U SelectedTask;
 
+#if (NUMBER_OF_PRIORITIES > 32)
+  PriorityType OSReadyList;
+  PriorityType OSBlockedList;                   ///< Initialized by PreInstallTasks
+#else
 #if (NUMBER_OF_PRIORITIES > 16)
   PriorityType OSReadyList = 0;
   PriorityType OSBlockedList = 0xFFFFFFFF;
@@ -128,8 +162,9 @@ volatile INT8U SelectedTask;
     PriorityType OSBlockedList = 0xFF;
   #endif
 #endif
+#endif
 
-static   INT16U OSTickCounter;                    ///< Incremented each tick timer - Used in delay and timeout functions
+static   TickType OSTickCounter;                    ///< Incremented each tick timer - Used in delay and timeout functions
 volatile INT32U OSDuty=0;                         ///< Used to compute the CPU load
 volatile INT32U OSDutyTmp=0;                      ///< Used to compute the CPU load
 
@@ -140,8 +175,17 @@ volatile INT16U LastOSDuty = 0;                   ///< Last CPU load computed
 #endif
 
 INT16U DutyCnt = 0;                               ///< Used to compute the CPU load
-INT32U TaskAlloc = 0;                             ///< Used to search a empty task control block
+INT32U TaskAlloc[TASK_ALLOC_WORDS];               ///< Used to search a empty task control block
 INT8U  iNesting = 0;                              ///< Used to inform if the current code position is an interrupt handler code
+#if (BRTOS_SCHED_LOCK_EN == 1)
+volatile INT8U OSSchedLockNesting = 0;            ///< Scheduler lock nesting - context switches are deferred while not zero
+#endif
+#if (BRTOS_MUTEX_EN == 1) && (BRTOS_MUTEX_INHERIT_EN == 1)
+volatile INT8U OSMutexInheritPending = FALSE;     ///< A mutex owner priority must change when the owner is ready to run
+#endif
+#if (BRTOS_RWLOCK_EN == 1)
+volatile INT8U OSRWLockBoostPending = FALSE;      ///< A lock holder must receive the priority ceiling when it is ready to run
+#endif
 
 ContextType *Tail;
 ContextType *Head;
@@ -152,7 +196,7 @@ volatile INT8U flag_load = TRUE;
 
 
 #if (NUMBER_OF_PRIORITIES > 16)
-  const PriorityType PriorityMask[configMAX_TASK_PRIORITY+1]=
+  const PriorityBits PriorityMask[PRIORITY_BITS]=
   {
     0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80,0x0100,0x0200,0x0400,0x0800,0x1000,0x2000,0x4000,0x8000,
     0x010000,0x020000,0x040000,0x080000,0x100000,0x200000,0x400000,0x800000,0x01000000,0x02000000,
@@ -160,12 +204,12 @@ volatile INT8U flag_load = TRUE;
   };
 #else
   #if (NUMBER_OF_PRIORITIES > 8)
-    const PriorityType PriorityMask[configMAX_TASK_PRIORITY+1]=
+    const PriorityBits PriorityMask[PRIORITY_BITS]=
     {
       0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80,0x0100,0x0200,0x0400,0x0800,0x1000,0x2000,0x4000,0x8000
     };
   #else
-    const PriorityType PriorityMask[configMAX_TASK_PRIORITY+1]=
+    const PriorityBits PriorityMask[PRIORITY_BITS]=
     {
       0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80
     };  
@@ -176,7 +220,7 @@ volatile INT8U flag_load = TRUE;
 ////////////////////////////////////////////////////////////
 /////      Semaphore Control Block Declaration         /////
 ////////////////////////////////////////////////////////////
-#if (BRTOS_SEM_EN == 1)
+#if ((BRTOS_SEM_EN == 1) && (BRTOS_OBJECT_POOL_EN == 0))
   /// Semahore Control Block
   BRTOS_Sem        BRTOS_Sem_Table[BRTOS_MAX_SEM];      // Table of EVENT control blocks
 #endif
@@ -185,7 +229,7 @@ volatile INT8U flag_load = TRUE;
 ////////////////////////////////////////////////////////////
 /////      Mutex Control Block Declaration             /////
 ////////////////////////////////////////////////////////////
-#if (BRTOS_MUTEX_EN == 1)
+#if ((BRTOS_MUTEX_EN == 1) && (BRTOS_OBJECT_POOL_EN == 0))
   /// Mutex Control Block
   BRTOS_Mutex      BRTOS_Mutex_Table[BRTOS_MAX_MUTEX];    // Table of EVENT control blocks
 #endif
@@ -194,7 +238,7 @@ volatile INT8U flag_load = TRUE;
 ////////////////////////////////////////////////////////////
 /////      Mbox Control Block Declaration              /////
 ////////////////////////////////////////////////////////////
-#if (BRTOS_MBOX_EN == 1)
+#if ((BRTOS_MBOX_EN == 1) && (BRTOS_OBJECT_POOL_EN == 0))
   /// MailBox Control Block
   BRTOS_Mbox       BRTOS_Mbox_Table[BRTOS_MAX_MBOX];     // Table of EVENT control blocks
 #endif
@@ -203,12 +247,88 @@ volatile INT8U flag_load = TRUE;
 ////////////////////////////////////////////////////////////
 /////      Queue Control Block Declaration             /////
 ////////////////////////////////////////////////////////////
-#if (BRTOS_QUEUE_EN == 1)
+#if ((BRTOS_QUEUE_EN == 1) && (BRTOS_OBJECT_POOL_EN == 0))
   /// Queue Control Block
   BRTOS_Queue      BRTOS_Queue_Table[BRTOS_MAX_QUEUE];    // Table of EVENT control blocks
 #endif
 
 
+////////////////////////////////////////////////////////////
+/////      Shared Object Pool Declaration              /////
+////////////////////////////////////////////////////////////
+#if (BRTOS_OBJECT_POOL_EN == 1)
+  /// Semaphore, mutex, mailbox and queue control blocks
+  BRTOS_Object     BRTOS_Object_Table[BRTOS_MAX_OBJECTS]; // Table of EVENT control blocks
+  INT8U            BRTOS_Object_Type[BRTOS_MAX_OBJECTS];  // Type of each pool entry
+  INT8U            BRTOS_Object_Gen[BRTOS_MAX_OBJECTS];   // Generation of each pool entry - changes on free
+  static INT8U     OSObjectNext[BRTOS_MAX_OBJECTS];       // Free list links
+  static INT8U     OSObjectFreeList;                      // First free entry
+#endif
+
+
+////////////////////////////////////////////////////////////
+/////      Memory Pool Control Block Declaration       /////
+////////////////////////////////////////////////////////////
+#if (BRTOS_MEMPOOL_EN == 1)
+  /// Memory Pool Control Block
+  BRTOS_MemPool    BRTOS_MemPool_Table[BRTOS_MAX_MEMPOOL];  // Table of EVENT control blocks
+#endif
+
+
+////////////////////////////////////////////////////////////
+/////      Event Flags Control Block Declaration       /////
+////////////////////////////////////////////////////////////
+#if (BRTOS_FLAG_EN == 1)
+  /// Event Flags Control Block
+  BRTOS_Flag       BRTOS_Flag_Table[BRTOS_MAX_FLAG];      // Table of EVENT control blocks
+#endif
+
+
+////////////////////////////////////////////////////////////
+/////      Stream Buffer Control Block Declaration     /////
+////////////////////////////////////////////////////////////
+#if (BRTOS_STREAM_EN == 1)
+  /// Stream Buffer Control Block
+  BRTOS_Stream     BRTOS_Stream_Table[BRTOS_MAX_STREAM];  // Table of EVENT control blocks
+#endif
+
+
+////////////////////////////////////////////////////////////
+/////      Event Set Control Block Declaration         /////
+////////////////////////////////////////////////////////////
+#if (BRTOS_SET_EN == 1)
+  /// Event Set Control Block
+  BRTOS_Set        BRTOS_Set_Table[BRTOS_MAX_SET];        // Table of EVENT control blocks
+#endif
+
+
+////////////////////////////////////////////////////////////
+/////      Reader-Writer Lock Control Block Declaration /////
+////////////////////////////////////////////////////////////
+#if (BRTOS_RWLOCK_EN == 1)
+  /// Reader-Writer Lock Control Block
+  BRTOS_RWLock     BRTOS_RWLock_Table[BRTOS_MAX_RWLOCK];  // Table of EVENT control blocks
+#endif
+
+
+////////////////////////////////////////////////////////////
+/////      Condition Variable Control Block Declaration /////
+////////////////////////////////////////////////////////////
+#if (BRTOS_COND_EN == 1)
+  /// Condition Variable Control Block
+  BRTOS_Cond       BRTOS_Cond_Table[BRTOS_MAX_COND];      // Table of EVENT control blocks
+#endif
+
+
+////////////////////////////////////////////////////////////
+/////      Barrier Control Block Declaration           /////
+////////////////////////////////////////////////////////////
+#if (BRTOS_BARRIER_EN == 1)
+  /// Barrier Control Block
+  BRTOS_Barrier    BRTOS_Barrier_Table[BRTOS_MAX_BARRIER]; // Table of EVENT control blocks
+#endif
+
+
 ///// RAM definitions
 #ifdef OS_CPU_TYPE
   #if (PROCESSOR == PIC18)
@@ -248,8 +368,50 @@ INT8U OSSchedule(void)
 	INT8U TaskSelect = 0xFF;
 	INT8U Priority   = 0;
 	
-  Priority = SAScheduler(OSReadyList & OSBlockedList);
+  #if (BRTOS_MUTEX_EN == 1) && (BRTOS_MUTEX_INHERIT_EN == 1)
+  // Lends the priority of the waiting tasks to mutex owners that were waiting for other events
+  if (OSMutexInheritPending)
+  {
+    OSMutexInheritUpdate();
+  }
+  #endif
+  
+  #if (BRTOS_RWLOCK_EN == 1)
+  // Gives the priority ceiling to lock holders that were waiting for other events
+  if (OSRWLockBoostPending)
+  {
+    OSRWLockUpdate();
+  }
+  #endif
+  
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+  // The current task keeps the processor while it holds the scheduler lock and is ready to run
+  if (OSSchedLockNesting && currentTask)
+  {
+    Priority = ContextTask[currentTask].Priority;
+    if (OSReadyListTest(currentTask, Priority))
+    {
+      return currentTask;
+    }
+  }
+  #endif
+  
+  Priority = PrioListHighestReady();
+  
+  #if (ROUND_ROBIN_EN == 1)
+  // Tasks that share a priority run in the order of the ready FIFO
+  TaskSelect = OSReadyHead[Priority];
+  #else
   TaskSelect = PriorityVector[Priority];
+  #endif
+  
+  #if (ROUND_ROBIN_EN == 1)
+  // A new task starts a full time slice
+  if (TaskSelect != currentTask)
+  {
+    OSTimeSliceCnt = 0;
+  }
+  #endif
   
 	return TaskSelect;
 }
@@ -262,20 +424,141 @@ INT8U OSSchedule(void)
 
 
 
+#if (ROUND_ROBIN_EN == 1)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      Get the current tick count                  /////
+/////      Round-Robin Ready FIFO Functions            /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-INT16U OSGetTickCount(void) 
+
+// Includes a task at the tail of the ready FIFO of a priority
+static void OSReadyEnqueue(INT8U iTask, INT8U iPriority)
 {
-  OS_SR_SAVE_VAR
-  INT16U cnt;
+  ContextTask[iTask].ReadyNext = 0;
   
-  OSEnterCritical();
-  cnt = OSTickCounter;
-  OSExitCritical();
-  return cnt;
+  if (OSReadyHead[iPriority] == 0)
+  {
+    OSReadyHead[iPriority] = iTask;
+    PrioListAdd(OSReadyList, iPriority);
+  }
+  else
+  {
+    ContextTask[OSReadyTail[iPriority]].ReadyNext = iTask;
+  }
+  
+  OSReadyTail[iPriority] = iTask;
+  ContextTask[iTask].ReadyState |= RR_QUEUED;
+}
+
+// Removes a task from the ready FIFO of a priority
+static void OSReadyDequeue(INT8U iTask, INT8U iPriority)
+{
+  INT8U Previous = 0;
+  INT8U Search = OSReadyHead[iPriority];
+  
+  // The running task is usually the head of the FIFO
+  while ((Search != 0) && (Search != iTask))
+  {
+    Previous = Search;
+    Search = ContextTask[Search].ReadyNext;
+  }
+  
+  if (Search == 0)
+  {
+    return;
+  }
+  
+  if (Previous == 0)
+  {
+    OSReadyHead[iPriority] = ContextTask[iTask].ReadyNext;
+  }
+  else
+  {
+    ContextTask[Previous].ReadyNext = ContextTask[iTask].ReadyNext;
+  }
+  
+  if (OSReadyTail[iPriority] == iTask)
+  {
+    OSReadyTail[iPriority] = Previous;
+  }
+  
+  // No more ready tasks with this priority
+  if (OSReadyHead[iPriority] == 0)
+  {
+    PrioListRemove(OSReadyList, iPriority);
+  }
+  
+  ContextTask[iTask].ReadyNext = 0;
+  ContextTask[iTask].ReadyState &= (INT8U)~RR_QUEUED;
+}
+
+// The ready FIFO of a priority keeps the tasks that are neither waiting nor blocked
+void OSReadyInsert(INT8U iTask, INT8U iPriority)
+{
+  ContextTask[iTask].ReadyState |= RR_READY;
+  
+  if ((ContextTask[iTask].ReadyState & (RR_BLOCKED | RR_QUEUED)) == 0)
+  {
+    OSReadyEnqueue(iTask, iPriority);
+  }
+}
+
+void OSReadyDelete(INT8U iTask, INT8U iPriority)
+{
+  ContextTask[iTask].ReadyState &= (INT8U)~RR_READY;
+  
+  if (ContextTask[iTask].ReadyState & RR_QUEUED)
+  {
+    OSReadyDequeue(iTask, iPriority);
+  }
+}
+
+void OSReadyMove(INT8U iTask, INT8U from, INT8U to)
+{
+  if (ContextTask[iTask].ReadyState & RR_QUEUED)
+  {
+    OSReadyDequeue(iTask, from);
+    OSReadyEnqueue(iTask, to);
+  }
+}
+
+void OSReadyBlock(INT8U iTask, INT8U iPriority)
+{
+  ContextTask[iTask].ReadyState |= RR_BLOCKED;
+  
+  if (ContextTask[iTask].ReadyState & RR_QUEUED)
+  {
+    OSReadyDequeue(iTask, iPriority);
+  }
+}
+
+void OSReadyUnblock(INT8U iTask, INT8U iPriority)
+{
+  ContextTask[iTask].ReadyState &= (INT8U)~RR_BLOCKED;
+  
+  if ((ContextTask[iTask].ReadyState & (RR_READY | RR_QUEUED)) == RR_READY)
+  {
+    OSReadyEnqueue(iTask, iPriority);
+  }
+}
+
+// Gives the time slice to the next ready task that shares the priority
+// Returns TRUE if other task received the time slice
+// Must be called inside a critical section
+INT8U OSTimeSliceRotate(INT8U iTask)
+{
+  INT8U iPriority = ContextTask[iTask].Priority;
+  
+  OSTimeSliceCnt = 0;
+  
+  if ((ContextTask[iTask].ReadyState & RR_QUEUED) && (OSReadyHead[iPriority] != OSReadyTail[iPriority]))
+  {
+    OSReadyDequeue(iTask, iPriority);
+    OSReadyEnqueue(iTask, iPriority);
+    return TRUE;
+  }
+  
+  return FALSE;
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -288,12 +571,118 @@ INT16U OSGetTickCount(void)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      Get the current tick count                  /////
+/////      Round-Robin Wait List Functions             /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-INT16U OSGetCount(void)
+
+// A priority of an event wait list may be shared by several waiting tasks.
+// Each task records the list where it waits and its arrival order.
+void OSWaitInsert(PriorityType *list, INT8U iTask, INT8U iPriority)
 {
-  return OSTickCounter;
+  ContextTask[iTask].WaitList = list;
+  ContextTask[iTask].WaitOrder = OSWaitOrder++;
+  PrioListAdd(*list, iPriority);
+}
+
+void OSWaitDelete(PriorityType *list, INT8U iTask, INT8U iPriority)
+{
+  if (ContextTask[iTask].WaitList != list)
+  {
+    return;
+  }
+  
+  ContextTask[iTask].WaitList = NULL;
+  
+  // Other tasks of the same priority may still be waiting
+  if (OSWaitFirst(list, iPriority) == 0)
+  {
+    PrioListRemove(*list, iPriority);
+  }
+}
+
+INT8U OSWaitFirst(PriorityType *list, INT8U iPriority)
+{
+  INT8U i;
+  INT8U First = 0;
+  
+  for (i = 1; i <= NUMBER_OF_TASKS; i++)
+  {
+    if ((ContextTask[i].WaitList == list) && (ContextTask[i].Priority == iPriority))
+    {
+      if ((First == 0) || ((INT16S)(ContextTask[i].WaitOrder - ContextTask[First].WaitOrder) < 0))
+      {
+        First = i;
+      }
+    }
+  }
+  
+  return First;
+}
+
+// The waiting tasks are released from the highest to the lowest priority,
+// and in arrival order inside a priority
+INT8U OSWaitNext(PriorityType *list, INT8U iTask)
+{
+  INT8U i;
+  INT8U Next = 0;
+  
+  for (i = 1; i <= NUMBER_OF_TASKS; i++)
+  {
+    if ((ContextTask[i].WaitList != list) || (i == iTask))
+    {
+      continue;
+    }
+    
+    // Only the tasks released after iTask
+    if ((iTask != 0) && ((ContextTask[i].Priority > ContextTask[iTask].Priority) ||
+        ((ContextTask[i].Priority == ContextTask[iTask].Priority) &&
+         ((INT16S)(ContextTask[i].WaitOrder - ContextTask[iTask].WaitOrder) < 0))))
+    {
+      continue;
+    }
+    
+    if ((Next == 0) || (ContextTask[i].Priority > ContextTask[Next].Priority) ||
+        ((ContextTask[i].Priority == ContextTask[Next].Priority) &&
+         ((INT16S)(ContextTask[i].WaitOrder - ContextTask[Next].WaitOrder) < 0)))
+    {
+      Next = i;
+    }
+  }
+  
+  return Next;
+}
+
+void OSWaitReadyAll(PriorityType *list)
+{
+  INT8U i;
+  INT8U First;
+  
+  do
+  {
+    First = 0;
+    
+    for (i = 1; i <= NUMBER_OF_TASKS; i++)
+    {
+      if ((ContextTask[i].WaitList == list) &&
+          ((First == 0) || ((INT16S)(ContextTask[i].WaitOrder - ContextTask[First].WaitOrder) < 0)))
+      {
+        First = i;
+      }
+    }
+    
+    if (First != 0)
+    {
+      ContextTask[First].WaitList = NULL;
+      
+      #if (VERBOSE == 1)
+      ContextTask[First].State = READY;
+      #endif
+      
+      OSReadyInsert(First, ContextTask[First].Priority);
+    }
+  } while (First != 0);
+  
+  PrioListInit(*list);
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -306,154 +695,121 @@ INT16U OSGetCount(void)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      Update the tick count                       /////
+/////      Task Yield Function                         /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-void OSIncCounter(void)
+
+INT8U OSYield(void)
 {
-	  OSTickCounter++;
-	  if (OSTickCounter == TickCountOverFlow) OSTickCounter = 0;
+  OS_SR_SAVE_VAR
+  
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
+  }
+  
+  if (currentTask)
+  {
+    OSEnterCritical();
+    
+    // Gives the processor to the next task with the same priority
+    if (OSTimeSliceRotate(currentTask) == TRUE)
+    {
+      ChangeContext();
+    }
+    
+    OSExitCritical();
+    
+    return OK;
+  }
+  else
+  {
+    return NOT_VALID_TASK;
+  }
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
+#endif
 
 
 
 
 
+#if (BRTOS_SCHED_LOCK_EN == 1)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      Task Delay Function in Tick Times           /////
+/////      Scheduler Lock Functions                    /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-// Atraso em passos de TickCount
-INT8U DelayTask(INT16U time_wait)
+INT8U OSSchedLock(void)
 {
   OS_SR_SAVE_VAR
-  INT32U timeout;
-  ContextType *Task = (ContextType*)&ContextTask[currentTask];
-   
+  INT8U err = OK;
+  
   if (iNesting > 0) {                                // See if caller is an interrupt
-     return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
+     return(IRQ_PEND_ERR);                           // Can't be locked by interrupt
   }
-
-  if (currentTask)
+  
+  if (!currentTask)
   {
-    
-    if (time_wait > 0)
-    {
-        OSEnterCritical();
-        
-        // BRTOS TRACE SUPPORT
-        #if (OSTRACE == 1) 
-            #if(OS_TRACE_BY_TASK == 1)
-            Update_OSTrace(currentTask, DELAYTASK);
-            #else
-            Update_OSTrace(Task->Priority, DELAYTASK);
-            #endif
-        #endif    
-
-        timeout = (INT32U)((INT32U)OSTickCounter + (INT32U)time_wait);
-        
-        if (timeout >= TICK_COUNT_OVERFLOW)
-        {
-          Task->TimeToWait = (INT16U)(timeout - TICK_COUNT_OVERFLOW);
-        }
-        else
-        {
-          Task->TimeToWait = (INT16U)timeout;
-        }
-        
-        // Put task into delay list
-        IncludeTaskIntoDelayList();
-        
-        #if (VERBOSE == 1)
-        Task->State = SUSPENDED;
-        Task->SuspendedType = DELAY;
-        #endif
-        
-        OSReadyList = OSReadyList & ~(PriorityMask[Task->Priority]);
-        
-        // Change context
-        // Return to task when occur delay overflow
-        ChangeContext();
-        
-        OSExitCritical();
-        
-        return OK;
-    }
-    else
-    {
-        return NO_TASK_DELAY;
-    }
+    return NOT_VALID_TASK;
+  }
+  
+  OSEnterCritical();
+  
+  if (OSSchedLockNesting < 255)
+  {
+    OSSchedLockNesting++;
   }
   else
   {
-    return NOT_VALID_TASK;
+    err = SCHED_LOCK_OVF;
   }
+  
+  OSExitCritical();
+  
+  return err;
 }
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-
-
 
 
 
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-/////   Task Delay Function in miliseconds, seconds,   /////
-/////   minutes and hours                              /////
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-// Miliseconds, seconds, minutes and hours delay
-INT8U DelayTaskHMSM(INT8U hours, INT8U minutes, INT8U seconds, INT16U miliseconds)
+INT8U OSSchedUnlock(void)
 {
-  INT32U ticks=0;
-  INT32U loops=0;
-  
-  if (minutes > 59)
-    return INVALID_TIME;
-  
-  if (seconds > 59)
-    return INVALID_TIME;
+  OS_SR_SAVE_VAR
+  INT8U err = OK;
   
-  if (miliseconds > 999)
-    return INVALID_TIME;  
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be unlocked by interrupt
+  }
   
-  ticks = (INT32U)hours   * 3600L * configTICK_RATE_HZ
-        + (INT32U)minutes * 60L   * configTICK_RATE_HZ
-        + (INT32U)seconds *         configTICK_RATE_HZ
-        + ((INT32U)miliseconds    * configTICK_RATE_HZ)/1000L;
+  OSEnterCritical();
   
-  // Task Delay limit = TickCounterOverflow
-  if (ticks > 0)
+  if (OSSchedLockNesting)
   {
-      loops = ticks / 60000L;
-      ticks = ticks % 60000L;
-      
-      (void)DelayTask((INT16U)ticks);
-      
-      while(loops > 0)
-      {
-        (void)DelayTask(60000);
-        loops--;
-      }
-      return OK;
+    OSSchedLockNesting--;
+    
+    // Tasks readied while the scheduler was locked run now
+    if (!OSSchedLockNesting)
+    {
+      ChangeContext();
+    }
   }
   else
   {
-      return NO_TASK_DELAY;
+    err = SCHED_NOT_LOCKED;
   }
+  
+  OSExitCritical();
+  
+  return err;
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
+#endif
 
 
 
@@ -461,76 +817,23 @@ INT8U DelayTaskHMSM(INT8U hours, INT8U minutes, INT8U seconds, INT16U milisecond
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      OS Tick Timer Function                      /////
+/////      Get the current tick count                  /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-
-void OS_TICK_HANDLER(void)
+TickType OSGetTickCount(void) 
 {
   OS_SR_SAVE_VAR
-  INT8U  iPrio = 0;  
-  ContextType *Task = Head;  
-   
-  ////////////////////////////////////////////////////
-  // Put task with delay overflow in the ready list //
-  ////////////////////////////////////////////////////  
-  while(Task != NULL)
-  {      
-      if (Task->TimeToWait == OSTickCounter)
-      {
-
-        iPrio = Task->Priority;
-        
-        #if (NESTING_INT == 1)
-        OSEnterCritical();
-        #endif        
-
-        // Put the task into the ready list
-        OSReadyList = OSReadyList | (PriorityMask[iPrio]);
-        
-        #if (VERBOSE == 1)
-            Task->State = READY;        
-        #endif
-        
-        Task->TimeToWait = EXIT_BY_TIMEOUT;
-        
-        #if (NESTING_INT == 1)
-        OSExitCritical();
-        #endif                  
-          
-        // Remove from delay list
-        RemoveFromDelayList();
-
-		#if ((PROCESSOR == ARM_Cortex_M0) || (PROCESSOR == ARM_Cortex_M3) || (PROCESSOR == ARM_Cortex_M4) || (PROCESSOR == ARM_Cortex_M4F))
-		OS_INT_EXIT_EXT();
-		#endif
-      }
- 
-      Task = Task->Next;
-  }
-
-  //////////////////////////////////////////
-  // System Load                          //
-  //////////////////////////////////////////  
-  #if (COMPUTES_CPU_LOAD == 1)
-     if (DutyCnt >= 1000)
-     {
-       DutyCnt = 0;
-       LastOSDuty = OSDuty;
-       OSDuty = 0;
-     }else
-     {    
-       if (!OSDutyTmp) OSDuty++;
-       OSDutyTmp = 0;
-       DutyCnt++;
-     }
-  #endif
-  //////////////////////////////////////////
-	
-  #if (TIMER_HOOK_EN == 1)
-    BRTOS_TimerHook();
-  #endif
+  TickType cnt;
+  
+  OSEnterCritical();
+  cnt = OSTickCounter;
+  OSExitCritical();
+  return cnt;
 }
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
 
 
 
@@ -538,25 +841,12 @@ void OS_TICK_HANDLER(void)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      OS Init Task Scheduler Function             /////
+/////      Get the current tick count                  /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-
-INT8U BRTOSStart(void)
+TickType OSGetCount(void)
 {
- #if (TASK_WITH_PARAMETERS == 1)
-  if (InstallIdle(&Idle,IDLE_STACK_SIZE,(void*)NULL) != OK) 
- #else
-  if (InstallIdle(&Idle,IDLE_STACK_SIZE) != OK)
- #endif
-  {
-    return NO_MEMORY;
-  };
-
-  currentTask = OSSchedule();
-  SPvalue = ContextTask[currentTask].StackPoint;
-  BTOSStartFirstTask();
-  return OK;
+  return OSTickCounter;
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -569,31 +859,13 @@ INT8U BRTOSStart(void)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      OS Function to Initialize RTOS Variables    /////
+/////      Update the tick count                       /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-
-void PreInstallTasks(void)
+void OSIncCounter(void)
 {
-  INT8U i=0;
-  OSTickCounter = 0;
-  currentTask = 0;
-  NumberOfInstalledTasks = 0;
-  TaskAlloc = 0;
-  iStackAddress = 0;
-  
-  for(i=0;i<configMAX_TASK_INSTALL;i++)
-  {
-    PriorityVector[i]=EMPTY_PRIO;
-  }
-    
-  Tail = NULL;
-  Head = NULL;
-  
-  #if (OSRTCEN == 1)
-    OSRTCSetup();
-  #endif
-  
+	  OSTickCounter++;
+	  if (OSTickCounter == TickCountOverFlow) OSTickCounter = 0;
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -606,44 +878,30 @@ void PreInstallTasks(void)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      Block Priority Function                     /////
+/////      Compute the expiration tick count           /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U BlockPriority(INT8U iPriority)
+// The tick count is computed modulo TICK_COUNT_OVERFLOW without
+// overflowing the tick type, so it works for 16 and 32 bits ticks
+TickType OSWakeTimeCompute(TickType time_wait)
 {
-  OS_SR_SAVE_VAR
-  INT8U BlockedTask = 0;
-  
-  if (iNesting > 0) {                                // See if caller is an interrupt
-     return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
-  }
-      
-  // Enter critical Section
-  if (currentTask)  
-    OSEnterCritical();
-
+  TickType remaining = (TickType)(TICK_COUNT_OVERFLOW - OSTickCounter);
 
-  // Detects the task priority
-  BlockedTask = PriorityVector[iPriority];  
-  // Block task with priority iPriority
-  #if (VERBOSE == 1)
-  ContextTask[BlockedTask].Blocked = TRUE;
-  #endif
-  
-  OSBlockedList = OSBlockedList & ~(PriorityMask[iPriority]);
-   
-  
-  if (currentTask == BlockedTask)
+  // Longest possible time to wait
+  if (time_wait >= TICK_COUNT_OVERFLOW)
   {
-     ChangeContext();
+    time_wait = (TickType)(TICK_COUNT_OVERFLOW - 1);
   }
 
-  // Exit critical Section
-  if (currentTask)
-    OSExitCritical();
-  
-  return OK;
+  if (time_wait >= remaining)
+  {
+    return (TickType)(time_wait - remaining);
+  }
+  else
+  {
+    return (TickType)(OSTickCounter + time_wait);
+  }
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -656,95 +914,72 @@ INT8U BlockPriority(INT8U iPriority)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      UnBlock Priority Function                   /////
+/////      Delay List Insertion Function               /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U UnBlockPriority(INT8U iPriority)
+// Number of ticks until the specified tick count is reached
+static TickType OSTicksToWake(TickType wake_time)
 {
-  OS_SR_SAVE_VAR
-  #if (VERBOSE == 1)
-  INT8U BlockedTask = 0;
-  #endif
-  
-  
-  // Enter Critical Section
-  #if (NESTING_INT == 0)
-  if (!iNesting)
-  #endif
-     OSEnterCritical();
-    
-  // Detects the task priority
-  #if (VERBOSE == 1)  
-  BlockedTask = PriorityVector[iPriority];  
-  ContextTask[BlockedTask].Blocked = FALSE;
-  #endif
-  
-  OSBlockedList = OSBlockedList | (PriorityMask[iPriority]);
-  
-  // check if we have unblocked a higher priority task  
-  if (currentTask)
+  if (wake_time > OSTickCounter)
   {
-    if (!iNesting)
-    {
-       ChangeContext();
-    }
+    return (TickType)(wake_time - OSTickCounter);
+  }
+  else
+  {
+    return (TickType)((TICK_COUNT_OVERFLOW - OSTickCounter) + wake_time);
   }
-  
-  // Exit Critical Section
-  #if (NESTING_INT == 0)
-  if (!iNesting)
-  #endif
-     OSExitCritical();
-
-  return OK;
 }
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-
-
-
 
+// The delay list is kept sorted by wake time, so the list head is always
+// the next timeout to expire. Must be called inside a critical section.
+void OSDelayListInsert(ContextType *Task)
+{
+  ContextType *Next = Head;
+  TickType    remaining;
 
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-/////      Block Task Function                         /////
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
+  remaining = OSTicksToWake(Task->TimeToWait);
 
-INT8U BlockTask(BRTOS_TH iTaskNumber)
-{
-  OS_SR_SAVE_VAR
-  INT8U iPriority = 0;
-  
-  if (iNesting > 0) {                                // See if caller is an interrupt
-     return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
+  // Search the first task that wakes up after the new one
+  // Tasks with the same wake time are kept in FIFO order
+  while((Next != NULL) && (OSTicksToWake(Next->TimeToWait) <= remaining))
+  {
+    Next = Next->Next;
   }
-    
-  // Enter critical Section
-  if (currentTask)
-    OSEnterCritical();    
 
-  // Determina a prioridade da funo
-  #if (VERBOSE == 1)
-  ContextTask[iTaskNumber].Blocked = TRUE;
-  #endif
-  iPriority = ContextTask[iTaskNumber].Priority;
-  
-  OSBlockedList = OSBlockedList & ~(PriorityMask[iPriority]);
-  
-  if (currentTask == iTaskNumber)
+  if (Next == NULL)
   {
-     ChangeContext();     
+    // Insert task at the end of the list
+    Task->Next = NULL;
+    Task->Previous = Tail;
+
+    if (Tail != NULL)
+    {
+      Tail->Next = Task;
+    }
+    else
+    {
+      // Init delay list
+      Head = Task;
+    }
+    Tail = Task;
   }
-  
-  // Exit critical Section
-  if (currentTask)
-    OSExitCritical();  
+  else
+  {
+    // Insert task before the first task that wakes up later
+    Task->Next = Next;
+    Task->Previous = Next->Previous;
 
-  return OK;
+    if (Next->Previous != NULL)
+    {
+      Next->Previous->Next = Task;
+    }
+    else
+    {
+      Head = Task;
+    }
+    Next->Previous = Task;
+  }
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -755,54 +990,74 @@ INT8U BlockTask(BRTOS_TH iTaskNumber)
 
 
 
+#if (TICKLESS_IDLE_EN == 1)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      UnBlock Task Function                       /////
+/////      Tickless Idle Function                      /////
+/////                                                  /////
+/////    Suppress the tick interrupts while there is   /////
+/////    no timeout to expire                          /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U UnBlockTask(BRTOS_TH iTaskNumber)
+void OSTicklessIdle(void)
 {
   OS_SR_SAVE_VAR
-  INT8U iPriority = 0;
-  
-  // Enter Critical Section
-  #if (NESTING_INT == 0)
-  if (!iNesting)
-  #endif
-     OSEnterCritical();
+  TickType expected;
+  INT16U   elapsed;
 
-  #if (VERBOSE == 1)
-  ContextTask[iTaskNumber].Blocked = FALSE;
+  OSEnterCritical();
+
+  // The delay list head is the next timeout to expire
+  if (Head != NULL)
+  {
+    expected = OSTicksToWake(Head->TimeToWait);
+  }
+  else
+  {
+    expected = TICK_COUNT_OVERFLOW - 1;
+  }
+
+  #if (TICK_COUNT_32BITS == 1)
+  // The port sleeps at most 0xFFFF ticks
+  if (expected > 0xFFFFUL) expected = 0xFFFFUL;
   #endif
-  
-  // Determina a prioridade da funo  
-  iPriority = ContextTask[iTaskNumber].Priority;
 
-  OSBlockedList = OSBlockedList | (PriorityMask[iPriority]);
-  
-  // check if we have unblocked a higher priority task  
-  if (currentTask)
+  if (expected < TICKLESS_IDLE_MIN_TICKS)
   {
-    if (!iNesting)
+    // Not worth to stop the tick timer
+    OSExitCritical();
+    OS_Wait;
+  }
+  else
+  {
+    // The port stops the periodic tick and sleeps up to the expected tick.
+    // The returned ticks do not include the tick whose interrupt is pending,
+    // so the tick counter never goes beyond the next timeout.
+    elapsed = TickTimerSleep((INT16U)expected);
+
+    if (elapsed > 0)
     {
-       ChangeContext();
+      OSTickCounter = OSWakeTimeCompute((TickType)elapsed);
+
+      // The suppressed ticks are idle time
+      #if (COMPUTES_CPU_LOAD == 1)
+        // A long sleep would wrap the sum
+        if (elapsed > 1000) elapsed = 1000;
+        DutyCnt = (INT16U)(DutyCnt + elapsed);
+        if (DutyCnt > 1000) DutyCnt = 1000;
+      #endif
     }
-  }
-  
-  // Exit Critical Section
-  #if (NESTING_INT == 0)
-  if (!iNesting)
-  #endif
-     OSExitCritical();
 
-  return OK;  
-  
+    // Pending interrupts, including the last tick, are served here
+    OSExitCritical();
+  }
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
+#endif
 
 
 
@@ -810,46 +1065,71 @@ INT8U UnBlockTask(BRTOS_TH iTaskNumber)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      Block Multiple Task Function                /////
+/////      Task Delay Function in Tick Times           /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U BlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
+// Atraso em passos de TickCount
+INT8U DelayTask(TickType time_wait)
 {
   OS_SR_SAVE_VAR
-  INT8U iTask = 0;
-  INT8U TaskFinish = 0;
-  INT8U iPriority = 0;  
-  
+  ContextType *Task = (ContextType*)&ContextTask[currentTask];
+   
   if (iNesting > 0) {                                // See if caller is an interrupt
      return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
   }
-    
-  // Enter critical Section
-  if (currentTask)
-    OSEnterCritical();
   
-  TaskFinish = (INT8U)(TaskStart + TaskNumber);
-  
-  for (iTask = TaskStart; iTask <TaskFinish; iTask++)
-  {
-    if (iTask != currentTask)
-    {      
-      #if (VERBOSE == 1)
-      ContextTask[iTask].Blocked = TRUE;
-      #endif
-      // Determina a prioridade da funo
-      iPriority = ContextTask[iTask].Priority;   
-      
-      OSBlockedList = OSBlockedList & ~(PriorityMask[iPriority]);
-    }
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+  if (OSSchedLockNesting > 0) {                      // See if the scheduler is locked
+     return(SCHED_LOCK_PEND_ERR);                    // Can't be blocked while locked
   }
-  
-  // Exit critical Section
+  #endif
+
   if (currentTask)
-    OSExitCritical();
+  {
+    
+    if (time_wait > 0)
+    {
+        OSEnterCritical();
+        
+        // BRTOS TRACE SUPPORT
+        #if (OSTRACE == 1) 
+            #if(OS_TRACE_BY_TASK == 1)
+            Update_OSTrace(currentTask, DELAYTASK);
+            #else
+            Update_OSTrace(Task->Priority, DELAYTASK);
+            #endif
+        #endif    
 
-  return OK;
+        Task->TimeToWait = OSWakeTimeCompute(time_wait);
+        
+        // Put task into delay list
+        IncludeTaskIntoDelayList();
+        
+        #if (VERBOSE == 1)
+        Task->State = SUSPENDED;
+        Task->SuspendedType = DELAY;
+        #endif
+        
+        OSReadyListRemove(currentTask, Task->Priority);
+        
+        // Change context
+        // Return to task when occur delay overflow
+        ChangeContext();
+        
+        OSExitCritical();
+        
+        return OK;
+    }
+    else
+    {
+        return NO_TASK_DELAY;
+    }
+  }
+  else
+  {
+    return NOT_VALID_TASK;
+  }
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -862,54 +1142,62 @@ INT8U BlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      unBlock Multiple Task Function              /////
+/////   Task Delay Function in miliseconds, seconds,   /////
+/////   minutes and hours                              /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-
-INT8U UnBlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
+// Miliseconds, seconds, minutes and hours delay
+INT8U DelayTaskHMSM(INT8U hours, INT8U minutes, INT8U seconds, INT16U miliseconds)
 {
-  OS_SR_SAVE_VAR
-  INT8U iTask = 0;
-  INT8U TaskFinish = 0;
-  INT8U iPriority = 0;    
+  INT32U ticks=0;
+  #if (TICK_COUNT_32BITS == 0)
+  INT32U loops=0;
+  #endif
   
-  if (iNesting > 0) {                                // See if caller is an interrupt
-     return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+  if (OSSchedLockNesting > 0) {                      // See if the scheduler is locked
+     return(SCHED_LOCK_PEND_ERR);                    // Can't be blocked while locked
   }
-    
-  // Enter critical Section
-  if (currentTask)
-    OSEnterCritical();
+  #endif
   
-  TaskFinish = (INT8U)(TaskStart + TaskNumber);
+  if (minutes > 59)
+    return INVALID_TIME;
   
-  for (iTask = TaskStart; iTask <TaskFinish; iTask++)
+  if (seconds > 59)
+    return INVALID_TIME;
+  
+  if (miliseconds > 999)
+    return INVALID_TIME;  
+  
+  ticks = (INT32U)hours   * 3600L * configTICK_RATE_HZ
+        + (INT32U)minutes * 60L   * configTICK_RATE_HZ
+        + (INT32U)seconds *         configTICK_RATE_HZ
+        + ((INT32U)miliseconds    * configTICK_RATE_HZ)/1000L;
+  
+  if (ticks > 0)
   {
-    // Determina a prioridade da funo
-    if (iTask != currentTask)
-    {
-      iPriority = ContextTask[iTask].Priority;
+    #if (TICK_COUNT_32BITS == 1)
+      // A single wake up, even for the longest delay
+      (void)DelayTask((TickType)ticks);
+    #else
+      // Task Delay limit = TickCounterOverflow
+      loops = ticks / 60000L;
+      ticks = ticks % 60000L;
       
-      #if (VERBOSE == 1)
-      ContextTask[iTask].Blocked = FALSE;
-      #endif
+      (void)DelayTask((INT16U)ticks);
       
-      OSBlockedList = OSBlockedList | (PriorityMask[iPriority]);
-    }
+      while(loops > 0)
+      {
+        (void)DelayTask(60000);
+        loops--;
+      }
+    #endif
+      return OK;
   }
-  
-  // check if we have unblocked a higher priority task  
-  if (currentTask)
+  else
   {
-    if (!iNesting)
-    {
-       ChangeContext();
-    }
-	// Exit critical Section
-	OSExitCritical();
-  } 
-
-  return OK;
+      return NO_TASK_DELAY;
+  }
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -922,37 +1210,187 @@ INT8U UnBlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////    OS Idle Task                                  /////
-/////                                                  /////
-/////    You must put the processor in standby mode    /////
-/////                                                  /////
+/////      OS Tick Timer Function                      /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-#if (TASK_WITH_PARAMETERS == 1) 
-  void Idle(void *parameters)
-#else
-  void Idle(void)
-#endif
+void OS_TICK_HANDLER(void)
 {
-  /* task setup */
-  #if (TASK_WITH_PARAMETERS == 1)  
-  (void)parameters;
-  #endif
-  
-  /* task main loop */
-  for (;;)
+  OS_SR_SAVE_VAR
+  ContextType *Task = Head;  
+   
+  ////////////////////////////////////////////////////
+  // Put task with delay overflow in the ready list //
+  ////////////////////////////////////////////////////
+  // The delay list is sorted by wake time, so only the head must be verified.
+  // A tick without expired timeouts costs a single comparison.
+  while((Task != NULL) && (Task->TimeToWait == OSTickCounter))
   {
-     #if (IDLE_HOOK_EN == 1)
-        IdleHook();
+        #if (NESTING_INT == 1)
+        OSEnterCritical();
+        #endif
+
+        // Put the task into the ready list
+        OSReadyListAdd((INT8U)(Task - ContextTask), Task->Priority);
+
+        #if (VERBOSE == 1)
+            Task->State = READY;
+        #endif
+
+        Task->TimeToWait = EXIT_BY_TIMEOUT;
+
+        #if (NESTING_INT == 1)
+        OSExitCritical();
+        #endif
+
+        // Remove from delay list
+        RemoveFromDelayList();
+
+		#if ((PROCESSOR == ARM_Cortex_M0) || (PROCESSOR == ARM_Cortex_M3) || (PROCESSOR == ARM_Cortex_M4) || (PROCESSOR == ARM_Cortex_M4F))
+		OS_INT_EXIT_EXT();
+		#endif
+
+      // Next task to wake up is now at the list head
+      Task = Head;
+  }
+
+  //////////////////////////////////////////
+  // Round-robin time slice               //
+  //////////////////////////////////////////
+  #if (ROUND_ROBIN_EN == 1)
+     #if (NESTING_INT == 1)
+     OSEnterCritical();
      #endif
      
-     #if (COMPUTES_CPU_LOAD == 1)
-        OSDutyTmp = 1;
-     #endif            
+     OSTimeSliceCnt++;
+     if (OSTimeSliceCnt >= TIME_SLICE_TICKS)
+     {
+       // Time slice expired, gives the processor to the next task with the same priority
+       if (OSTimeSliceRotate(currentTask) == TRUE)
+       {
+         #if ((PROCESSOR == ARM_Cortex_M0) || (PROCESSOR == ARM_Cortex_M3) || (PROCESSOR == ARM_Cortex_M4) || (PROCESSOR == ARM_Cortex_M4F))
+         OS_INT_EXIT_EXT();
+         #endif
+       }
+     }
      
-     OS_Wait;
+     #if (NESTING_INT == 1)
+     OSExitCritical();
+     #endif
+  #endif
+  
+  //////////////////////////////////////////
+  // System Load                          //
+  //////////////////////////////////////////  
+  #if (COMPUTES_CPU_LOAD == 1)
+     if (DutyCnt >= 1000)
+     {
+       DutyCnt = 0;
+       LastOSDuty = OSDuty;
+       OSDuty = 0;
+     }else
+     {    
+       if (!OSDutyTmp) OSDuty++;
+       OSDutyTmp = 0;
+       DutyCnt++;
+     }
+  #endif
+  //////////////////////////////////////////
+	
+  #if (TIMER_HOOK_EN == 1)
+    BRTOS_TimerHook();
+  #endif
+}
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      OS Init Task Scheduler Function             /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U BRTOSStart(void)
+{
+ #if (TASK_WITH_PARAMETERS == 1)
+  if (InstallIdle(&Idle,IDLE_STACK_SIZE,(void*)NULL) != OK) 
+ #else
+  if (InstallIdle(&Idle,IDLE_STACK_SIZE) != OK)
+ #endif
+  {
+    return NO_MEMORY;
+  };
+
+  currentTask = OSSchedule();
+  SPvalue = ContextTask[currentTask].StackPoint;
+  BTOSStartFirstTask();
+  return OK;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      OS Function to Initialize RTOS Variables    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+void PreInstallTasks(void)
+{
+  INT16U i=0;
+  OSTickCounter = 0;
+  currentTask = 0;
+  NumberOfInstalledTasks = 0;
+  iStackAddress = 0;
+  
+  for(i=0;i<TASK_ALLOC_WORDS;i++)
+  {
+    TaskAlloc[i] = 0;
+  }
+  
+  #if (TASK_DELETE_EN == 1)
+  for(i=0;i<(NUMBER_OF_TASKS + 1);i++)
+  {
+    OSStackFreeList[i].Words = 0;
+  }
+  #endif
+  
+  for(i=0;i<configMAX_TASK_INSTALL;i++)
+  {
+    PriorityVector[i]=EMPTY_PRIO;
+    
+    #if (ROUND_ROBIN_EN == 1)
+    OSReadyHead[i] = 0;
+    OSReadyTail[i] = 0;
+    PriorityTasks[i] = 0;
+    #endif
+  }
+  
+  #if (NUMBER_OF_PRIORITIES > 32)
+  // No ready priority and no blocked priority
+  PrioListInit(OSReadyList);
+  for(i=0;i<PRIORITY_GROUPS;i++)
+  {
+    OSBlockedList.Bits[i] = 0xFFFFFFFF;
   }
+  OSBlockedList.Group = (INT8U)((1u << PRIORITY_GROUPS) - 1u);
+  #endif
+    
+  Tail = NULL;
+  Head = NULL;
+  
+  #if (OSRTCEN == 1)
+    OSRTCSetup();
+  #endif
+  
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -962,83 +1400,511 @@ INT8U UnBlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
 
 
 
-#if (TASK_WITH_PARAMETERS == 1)
-  INT8U InstallTask(void(*FctPtr)(void *),const CHAR8 *TaskName, INT16U USER_STACKED_BYTES,INT8U iPriority, void *parameters, OS_CPU_TYPE *TaskHandle)
-#else
-  INT8U InstallTask(void(*FctPtr)(void),const CHAR8 *TaskName, INT16U USER_STACKED_BYTES,INT8U iPriority, OS_CPU_TYPE *TaskHandle)
-#endif
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Block Priority Function                     /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U BlockPriority(INT8U iPriority)
 {
   OS_SR_SAVE_VAR
-  INT8U i = 0; 
-  INT8U TaskNumber = 0;
-  ContextType * Task;    
+  INT8U BlockedTask = 0;
   
-   if (currentTask)
-    // Enter Critical Section
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
+  }
+  
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+  if ((OSSchedLockNesting > 0) && (ContextTask[currentTask].Priority == iPriority)) {
+     return(SCHED_LOCK_PEND_ERR);                    // Can't block itself while the scheduler is locked
+  }
+  #endif
+      
+  // Enter critical Section
+  if (currentTask)  
     OSEnterCritical();
-    
-   // Fix the stack size to the cpu type
-   USER_STACKED_BYTES = USER_STACKED_BYTES - (USER_STACKED_BYTES % sizeof(OS_CPU_TYPE));
-
-   if (USER_STACKED_BYTES < NUMBER_MIN_OF_STACKED_BYTES)
-   {
-       if (currentTask)
-        // Exit Critical Section
-        OSExitCritical();
-       return STACK_SIZE_TOO_SMALL;
-   }
-   
-   if ((iStackAddress + (USER_STACKED_BYTES / sizeof(OS_CPU_TYPE))) > (HEAP_SIZE / sizeof(OS_CPU_TYPE)))
-   {
-       if (currentTask)
-        // Exit Critical Section
-        OSExitCritical();
-       return NO_MEMORY;
-   }
 
-   if (iPriority)
-   {
-     if (iPriority > configMAX_TASK_PRIORITY)
-     {
-        if (currentTask)
-         // Exit Critical Section
-         OSExitCritical();        
-        return END_OF_AVAILABLE_PRIORITIES;
-     }
-     
-     if (PriorityVector[iPriority] != EMPTY_PRIO)
-     {
-        if (currentTask)
-         // Exit Critical Section
-         OSExitCritical();        
-        return BUSY_PRIORITY;
-     }
-   }
-   else
-   {
-      if (currentTask)
-       // Exit Critical Section
-       OSExitCritical();
-      return CANNOT_ASSIGN_IDLE_TASK_PRIO;
-   }
 
-   NumberOfInstalledTasks++;
+  #if (ROUND_ROBIN_EN == 1)
+  // Block all the tasks that share the priority iPriority
+  for (BlockedTask = 1; BlockedTask <= NUMBER_OF_TASKS; BlockedTask++)
+  {
+    if (ContextTask[BlockedTask].Priority == iPriority)
+    {
+      #if (VERBOSE == 1)
+      ContextTask[BlockedTask].Blocked = TRUE;
+      #endif
       
-   // Number Task Discovery
-   for(i=0;i<NUMBER_OF_TASKS;i++)
-   {
-      INT32U teste = 1;
-      teste = teste<<i;
-    
-      if (!(teste & TaskAlloc))
-      {
-         TaskNumber = i+1;
-         TaskAlloc = TaskAlloc | teste;
-         break;
-      }
-   }   
+      OSReadyListBlock(BlockedTask, iPriority);
+    }
+  }
+  
+  if (currentTask && (ContextTask[currentTask].Priority == iPriority))
+  {
+     ChangeContext();
+  }
+  #else
+  // Detects the task priority
+  BlockedTask = PriorityVector[iPriority];  
+  // Block task with priority iPriority
+  #if (VERBOSE == 1)
+  ContextTask[BlockedTask].Blocked = TRUE;
+  #endif
+  
+  OSReadyListBlock(BlockedTask, iPriority);
    
-   // Verifica se encontrou lugar para o contexto da tarefa
+  
+  if (currentTask == BlockedTask)
+  {
+     ChangeContext();
+  }
+  #endif
+
+  // Exit critical Section
+  if (currentTask)
+    OSExitCritical();
+  
+  return OK;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      UnBlock Priority Function                   /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U UnBlockPriority(INT8U iPriority)
+{
+  OS_SR_SAVE_VAR
+  INT8U BlockedTask = 0;
+  
+  
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+  
+  #if (ROUND_ROBIN_EN == 1)
+  // Unblock all the tasks that share the priority iPriority
+  for (BlockedTask = 1; BlockedTask <= NUMBER_OF_TASKS; BlockedTask++)
+  {
+    if (ContextTask[BlockedTask].Priority == iPriority)
+    {
+      #if (VERBOSE == 1)
+      ContextTask[BlockedTask].Blocked = FALSE;
+      #endif
+      
+      OSReadyListUnblock(BlockedTask, iPriority);
+    }
+  }
+  #else
+  // Detects the task priority
+  BlockedTask = PriorityVector[iPriority];  
+  #if (VERBOSE == 1)  
+  ContextTask[BlockedTask].Blocked = FALSE;
+  #endif
+  
+  OSReadyListUnblock(BlockedTask, iPriority);
+  #endif
+  
+  // check if we have unblocked a higher priority task  
+  if (currentTask)
+  {
+    if (!iNesting)
+    {
+       ChangeContext();
+    }
+  }
+  
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+
+  return OK;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Block Task Function                         /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U BlockTask(BRTOS_TH iTaskNumber)
+{
+  OS_SR_SAVE_VAR
+  INT8U iPriority = 0;
+  
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
+  }
+  
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+  if ((OSSchedLockNesting > 0) && (iTaskNumber == currentTask)) {
+     return(SCHED_LOCK_PEND_ERR);                    // Can't block itself while the scheduler is locked
+  }
+  #endif
+    
+  // Enter critical Section
+  if (currentTask)
+    OSEnterCritical();    
+
+  // Determina a prioridade da funo
+  #if (VERBOSE == 1)
+  ContextTask[iTaskNumber].Blocked = TRUE;
+  #endif
+  iPriority = ContextTask[iTaskNumber].Priority;
+  
+  OSReadyListBlock(iTaskNumber, iPriority);
+  
+  if (currentTask == iTaskNumber)
+  {
+     ChangeContext();     
+  }
+  
+  // Exit critical Section
+  if (currentTask)
+    OSExitCritical();  
+
+  return OK;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      UnBlock Task Function                       /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U UnBlockTask(BRTOS_TH iTaskNumber)
+{
+  OS_SR_SAVE_VAR
+  INT8U iPriority = 0;
+  
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+
+  #if (VERBOSE == 1)
+  ContextTask[iTaskNumber].Blocked = FALSE;
+  #endif
+  
+  // Determina a prioridade da funo  
+  iPriority = ContextTask[iTaskNumber].Priority;
+
+  OSReadyListUnblock(iTaskNumber, iPriority);
+  
+  // check if we have unblocked a higher priority task  
+  if (currentTask)
+  {
+    if (!iNesting)
+    {
+       ChangeContext();
+    }
+  }
+  
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+
+  return OK;  
+  
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Block Multiple Task Function                /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U BlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
+{
+  OS_SR_SAVE_VAR
+  INT8U iTask = 0;
+  INT8U TaskFinish = 0;
+  INT8U iPriority = 0;  
+  
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
+  }
+    
+  // Enter critical Section
+  if (currentTask)
+    OSEnterCritical();
+  
+  TaskFinish = (INT8U)(TaskStart + TaskNumber);
+  
+  for (iTask = TaskStart; iTask <TaskFinish; iTask++)
+  {
+    if (iTask != currentTask)
+    {      
+      #if (VERBOSE == 1)
+      ContextTask[iTask].Blocked = TRUE;
+      #endif
+      // Determina a prioridade da funo
+      iPriority = ContextTask[iTask].Priority;   
+      
+      OSReadyListBlock(iTask, iPriority);
+    }
+  }
+  
+  // Exit critical Section
+  if (currentTask)
+    OSExitCritical();
+
+  return OK;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      unBlock Multiple Task Function              /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U UnBlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
+{
+  OS_SR_SAVE_VAR
+  INT8U iTask = 0;
+  INT8U TaskFinish = 0;
+  INT8U iPriority = 0;    
+  
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be blocked by interrupt
+  }
+    
+  // Enter critical Section
+  if (currentTask)
+    OSEnterCritical();
+  
+  TaskFinish = (INT8U)(TaskStart + TaskNumber);
+  
+  for (iTask = TaskStart; iTask <TaskFinish; iTask++)
+  {
+    // Determina a prioridade da funo
+    if (iTask != currentTask)
+    {
+      iPriority = ContextTask[iTask].Priority;
+      
+      #if (VERBOSE == 1)
+      ContextTask[iTask].Blocked = FALSE;
+      #endif
+      
+      OSReadyListUnblock(iTask, iPriority);
+    }
+  }
+  
+  // check if we have unblocked a higher priority task  
+  if (currentTask)
+  {
+    if (!iNesting)
+    {
+       ChangeContext();
+    }
+	// Exit critical Section
+	OSExitCritical();
+  } 
+
+  return OK;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////    OS Idle Task                                  /////
+/////                                                  /////
+/////    You must put the processor in standby mode    /////
+/////                                                  /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#if (TASK_WITH_PARAMETERS == 1) 
+  void Idle(void *parameters)
+#else
+  void Idle(void)
+#endif
+{
+  /* task setup */
+  #if (TASK_WITH_PARAMETERS == 1)  
+  (void)parameters;
+  #endif
+  
+  /* task main loop */
+  for (;;)
+  {
+     #if (IDLE_HOOK_EN == 1)
+        IdleHook();
+     #endif
+     
+     #if (COMPUTES_CPU_LOAD == 1)
+        OSDutyTmp = 1;
+     #endif
+
+     #if (STACK_WATERMARK_EN == 1)
+        OSStackWatermarkUpdate();
+     #endif
+
+     #if (TICKLESS_IDLE_EN == 1)
+        OSTicklessIdle();
+     #else
+        OS_Wait;
+     #endif
+  }
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+#if (TASK_WITH_PARAMETERS == 1)
+  INT8U InstallTask(void(*FctPtr)(void *),const CHAR8 *TaskName, INT16U USER_STACKED_BYTES,INT8U iPriority, void *parameters, OS_CPU_TYPE *TaskHandle)
+#else
+  INT8U InstallTask(void(*FctPtr)(void),const CHAR8 *TaskName, INT16U USER_STACKED_BYTES,INT8U iPriority, OS_CPU_TYPE *TaskHandle)
+#endif
+{
+  OS_SR_SAVE_VAR
+  INT8U i = 0; 
+  INT8U TaskNumber = 0;
+  ContextType * Task;    
+  #if (TASK_DELETE_EN == 1)
+  INT8U StackFree;
+  INT16U StackTop;
+  #endif
+  
+   if (currentTask)
+    // Enter Critical Section
+    OSEnterCritical();
+    
+   // Fix the stack size to the cpu type
+   USER_STACKED_BYTES = USER_STACKED_BYTES - (USER_STACKED_BYTES % sizeof(OS_CPU_TYPE));
+
+   if (USER_STACKED_BYTES < NUMBER_MIN_OF_STACKED_BYTES)
+   {
+       if (currentTask)
+        // Exit Critical Section
+        OSExitCritical();
+       return STACK_SIZE_TOO_SMALL;
+   }
+   
+   #if (TASK_DELETE_EN == 1)
+   // Search a stack released by a deleted task before using the free heap
+   StackFree = OSStackFreeSearch(USER_STACKED_BYTES / sizeof(OS_CPU_TYPE));
+   if (StackFree == STACK_FREE_NONE)
+   #endif
+   if ((iStackAddress + (USER_STACKED_BYTES / sizeof(OS_CPU_TYPE))) > (HEAP_SIZE / sizeof(OS_CPU_TYPE)))
+   {
+       if (currentTask)
+        // Exit Critical Section
+        OSExitCritical();
+       return NO_MEMORY;
+   }
+
+   if (iPriority)
+   {
+     #if (configMAX_TASK_PRIORITY < 255)
+     if (iPriority > configMAX_TASK_PRIORITY)
+     {
+        if (currentTask)
+         // Exit Critical Section
+         OSExitCritical();        
+        return END_OF_AVAILABLE_PRIORITIES;
+     }
+     #endif
+     
+     #if (ROUND_ROBIN_EN == 1)
+     // A priority is shared with the tasks already installed with it
+     if ((PriorityVector[iPriority] != EMPTY_PRIO) && (PriorityTasks[iPriority] == 0))
+     #else
+     if (PriorityVector[iPriority] != EMPTY_PRIO)
+     #endif
+     {
+        if (currentTask)
+         // Exit Critical Section
+         OSExitCritical();        
+        return BUSY_PRIORITY;
+     }
+   }
+   else
+   {
+      if (currentTask)
+       // Exit Critical Section
+       OSExitCritical();
+      return CANNOT_ASSIGN_IDLE_TASK_PRIO;
+   }
+
+   NumberOfInstalledTasks++;
+      
+   // Number Task Discovery
+   for(i=0;i<NUMBER_OF_TASKS;i++)
+   {
+      INT32U teste = 1;
+      teste = teste<<(i & 0x1F);
+    
+      if (!(teste & TaskAlloc[i >> 5]))
+      {
+         TaskNumber = i+1;
+         TaskAlloc[i >> 5] = TaskAlloc[i >> 5] | teste;
+         break;
+      }
+   }   
+   
+   // Verifica se encontrou lugar para o contexto da tarefa
    if (TaskNumber == 0) 
    {    
       if (currentTask)
@@ -1046,76 +1912,969 @@ INT8U UnBlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
         // Exit Critical Section
         OSExitCritical();   
       }
-      return END_OF_AVAILABLE_TCB;
-   }
-     
-   // Copy task handle id
-   if (TaskHandle != NULL) 
-   {
-      *TaskHandle = (OS_CPU_TYPE)TaskNumber;
-   }
-   
-   Task = (ContextType*)&ContextTask[TaskNumber];      
-   Task->TaskName = TaskName;
+      return END_OF_AVAILABLE_TCB;
+   }
+     
+   // Copy task handle id
+   if (TaskHandle != NULL) 
+   {
+      *TaskHandle = (OS_CPU_TYPE)TaskNumber;
+   }
+   
+   Task = (ContextType*)&ContextTask[TaskNumber];      
+   Task->TaskName = TaskName;
+
+   #if (TASK_DELETE_EN == 1)
+   StackTop = iStackAddress;
+   if (StackFree != STACK_FREE_NONE)
+   {
+      // The task stack takes the released region
+      iStackAddress = OSStackFreeTake(StackFree, USER_STACKED_BYTES / sizeof(OS_CPU_TYPE));
+      StackAddress = STACK_ADDRESS(iStackAddress);
+   }
+   #endif
+   
+   #if ((TASK_DELETE_EN == 1) || (STACK_WATERMARK_EN == 1))
+   Task->StackIndex = iStackAddress;
+   Task->StackWords = USER_STACKED_BYTES / sizeof(OS_CPU_TYPE);
+   #endif
+   
+   #if (STACK_WATERMARK_EN == 1)
+   OSStackPaint(Task);
+   #endif
+
+   // Posiciona o inicio do stack da tarefa
+   // no inicio da disponibilidade de RAM do HEAP
+	#if STACK_GROWTH == 1
+	 Task->StackPoint = StackAddress + NUMBER_MIN_OF_STACKED_BYTES;
+	#else
+	 Task->StackPoint = StackAddress + (USER_STACKED_BYTES - NUMBER_MIN_OF_STACKED_BYTES);
+  #endif
+                                                                      
+  // Virtual Stack Init
+	#if STACK_GROWTH == 1
+	Task->StackInit = StackAddress;
+	#else
+	Task->StackInit = StackAddress + USER_STACKED_BYTES;
+	#endif
+    
+
+   // Determina a prioridade da funo
+   Task->Priority = iPriority;
+
+   // Determina a tarefa que ir ocupar esta prioridade
+   #if (ROUND_ROBIN_EN == 1)
+   // The first task of a shared priority occupies it
+   if (PriorityTasks[iPriority] == 0)
+   {
+      PriorityVector[iPriority] = TaskNumber;
+   }
+   PriorityTasks[iPriority]++;
+   
+   Task->ReadyState = 0;
+   Task->ReadyNext = 0;
+   Task->WaitList = NULL;
+   #else
+   PriorityVector[iPriority] = TaskNumber;
+   #endif
+   // set the function entry address in the context
+   
+   // Fill the virtual task stack
+   #if (TASK_WITH_PARAMETERS == 1)
+      CreateVirtualStack(FctPtr, USER_STACKED_BYTES, parameters);
+   #else
+      CreateVirtualStack(FctPtr, USER_STACKED_BYTES);   
+   #endif
+   
+   // Incrementa o contador de bytes do stack virtual (HEAP)
+   iStackAddress = iStackAddress + (USER_STACKED_BYTES / sizeof(OS_CPU_TYPE));
+   
+   // Posiciona o endereo de stack virtual p/ a prxima tarefa instalada
+   StackAddress = StackAddress + USER_STACKED_BYTES;
+   
+   #if (TASK_DELETE_EN == 1)
+   if (StackFree != STACK_FREE_NONE)
+   {
+      // The free heap was not used
+      iStackAddress = StackTop;
+      StackAddress = STACK_ADDRESS(StackTop);
+   }
+   #endif
+
+   Task->TimeToWait = NO_TIMEOUT;
+   Task->Next     =  NULL;
+   Task->Previous =  NULL;
+   
+   #if (TASK_NOTIFY_EN == 1)
+   Task->NotifyValue = 0;
+   Task->NotifyState = NOTIFY_NONE;
+   #endif
+   
+   #if (TASK_RESERVATION_EN == 1)
+   Task->Reservation = NULL;
+   #endif
+   
+   #if (VERBOSE == 1)
+   Task->Blocked = FALSE;
+   Task->State = READY;
+   #endif   
+   
+   OSReadyListAdd(TaskNumber, iPriority);   
+   
+   if (currentTask)
+    // Exit Critical Section
+    OSExitCritical();   
+   
+   return OK;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+#if (TASK_DELETE_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Stack Free List Functions                   /////
+/////                                                  /////
+/////  The stacks released by OSTaskDelete are kept in /////
+/////  a table of free regions (best-fit)              /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Returns the smallest released region that fits the stack, or STACK_FREE_NONE
+static INT8U OSStackFreeSearch(INT16U Words)
+{
+  INT8U i;
+  INT8U Best = STACK_FREE_NONE;
+  
+  for(i=0;i<(NUMBER_OF_TASKS + 1);i++)
+  {
+    if ((OSStackFreeList[i].Words >= Words) &&
+        ((Best == STACK_FREE_NONE) || (OSStackFreeList[i].Words < OSStackFreeList[Best].Words)))
+    {
+      Best = i;
+    }
+  }
+  
+  return Best;
+}
+
+
+// Takes the stack from the beginning of a released region
+static INT16U OSStackFreeTake(INT8U Entry, INT16U Words)
+{
+  INT16U Index = OSStackFreeList[Entry].Index;
+  
+  OSStackFreeList[Entry].Index = Index + Words;
+  OSStackFreeList[Entry].Words = OSStackFreeList[Entry].Words - Words;
+  
+  return Index;
+}
+
+
+// Releases a stack region. The region is merged with the adjacent free
+// regions and given back to the free heap when it is at the heap top.
+static void OSStackRelease(INT16U Index, INT16U Words)
+{
+  INT8U i;
+  INT8U Empty = STACK_FREE_NONE;
+  
+  for(i=0;i<(NUMBER_OF_TASKS + 1);i++)
+  {
+    if (OSStackFreeList[i].Words)
+    {
+      if ((OSStackFreeList[i].Index + OSStackFreeList[i].Words) == Index)
+      {
+        // Free region just below
+        Index = OSStackFreeList[i].Index;
+        Words = Words + OSStackFreeList[i].Words;
+        OSStackFreeList[i].Words = 0;
+      }
+      else
+      {
+        if (OSStackFreeList[i].Index == (Index + Words))
+        {
+          // Free region just above
+          Words = Words + OSStackFreeList[i].Words;
+          OSStackFreeList[i].Words = 0;
+        }
+      }
+    }
+    
+    if (OSStackFreeList[i].Words == 0)
+    {
+      Empty = i;
+    }
+  }
+  
+  if ((Index + Words) == iStackAddress)
+  {
+    iStackAddress = Index;
+    StackAddress = STACK_ADDRESS(Index);
+  }
+  else
+  {
+    // There is always an empty entry: each free region is below a used stack
+    OSStackFreeList[Empty].Index = Index;
+    OSStackFreeList[Empty].Words = Words;
+  }
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+// Removes a task from an event wait list
+static void OSEventWaitRemove(PriorityType *WaitList, INT8U *Wait, INT8U iTask, INT8U iPriority)
+{
+  if (OSWaitListTest(*WaitList, iTask, iPriority))
+  {
+    OSWaitListRemove(*WaitList, iTask, iPriority);
+    *Wait = (INT8U)(*Wait - 1);
+  }
+}
+
+
+#if (TASK_RESERVATION_EN == 1)
+// Gives the slot kept to a deleted task to the highest priority task of the wait list
+// Returns FALSE if no task is waiting, and the caller releases the slot
+static INT8U OSReservationTransfer(PriorityType *WaitList, INT8U *Wait, void *event)
+{
+  INT8U iPriority;
+  INT8U TaskSelect;
+  
+  if (*Wait == 0)
+  {
+    return FALSE;
+  }
+  
+  iPriority = PrioListHighest(*WaitList);
+  TaskSelect = OSWaitListTask(*WaitList, iPriority);
+  OSWaitListRemove(*WaitList, TaskSelect, iPriority);
+  *Wait = (INT8U)(*Wait - 1);
+  
+  ContextTask[TaskSelect].Reservation = event;
+  
+  #if (VERBOSE == 1)
+  ContextTask[TaskSelect].State = READY;
+  #endif
+  
+  OSReadyListAdd(TaskSelect, iPriority);
+  
+  return TRUE;
+}
+#endif
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Task Delete Function                        /////
+/////                                                  /////
+/////  Parameters:                                     /////
+/////  Task handle id                                  /////
+/////                                                  /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSTaskDelete(BRTOS_TH iTaskNumber)
+{
+  OS_SR_SAVE_VAR
+  INT8U i;
+  INT8U iPriority;
+  ContextType *Task;
+  ContextType *Search;
+  #if (BRTOS_SEM_EN == 1)
+  BRTOS_Sem   *sem;
+  #endif
+  #if (BRTOS_MUTEX_EN == 1)
+  BRTOS_Mutex *mutex;
+  #endif
+  #if (BRTOS_MBOX_EN == 1)
+  BRTOS_Mbox  *mbox;
+  #endif
+  #if (BRTOS_QUEUE_EN == 1)
+  BRTOS_Queue *queue;
+  #endif
+  INT8U woken = FALSE;
+  
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be deleted by interrupt
+  }
+  
+  // The idle task can not be deleted
+  if ((iTaskNumber == 0) || (iTaskNumber > NUMBER_OF_TASKS))
+  {
+     return NOT_VALID_TASK;
+  }
+  
+  // Enter critical Section
+  if (currentTask)
+    OSEnterCritical();
+  
+  i = (INT8U)(iTaskNumber - 1);
+  if (!(TaskAlloc[i >> 5] & ((INT32U)1 << (i & 0x1F))))
+  {
+     // Exit critical Section
+     if (currentTask)
+       OSExitCritical();
+     return NOT_VALID_TASK;
+  }
+  
+  #if (BRTOS_MUTEX_EN == 1)
+  // The priority of a mutex owner may be raised to the mutex ceiling
+  for(i=0;i<MUTEX_ENTRIES;i++)
+  {
+    mutex = MutexEntry(i);
+    if ((mutex != NULL) && (mutex->OSEventAllocated == TRUE) && (mutex->OSEventOwner == iTaskNumber))
+    {
+       // Exit critical Section
+       if (currentTask)
+         OSExitCritical();
+       return TASK_OWNS_MUTEX;
+    }
+  }
+  #endif
+  
+  #if (BRTOS_RWLOCK_EN == 1)
+  // The priority of a lock holder may be raised to the lock ceiling
+  for(i=0;i<BRTOS_MAX_RWLOCK;i++)
+  {
+    if ((BRTOS_RWLock_Table[i].OSEventAllocated == TRUE) && ((BRTOS_RWLock_Table[i].OSRWWriter == iTaskNumber) ||
+        (BRTOS_RWLock_Table[i].OSRWReadTasks[(iTaskNumber - 1) >> 5] & ((INT32U)1 << ((iTaskNumber - 1) & 0x1F)))))
+    {
+       // Exit critical Section
+       if (currentTask)
+         OSExitCritical();
+       return TASK_OWNS_MUTEX;
+    }
+  }
+  #endif
+  
+  Task = &ContextTask[iTaskNumber];
+  iPriority = Task->Priority;
+  
+  #if (BRTOS_MUTEX_INHERIT_EN == 1)
+  #if (ROUND_ROBIN_EN == 1)
+  // The priority of a task waiting for a mutex may be lent to the mutex owner.
+  // A shared priority is not bound to a task: the owner keeps it while other
+  // task of this priority waits for the mutex.
+  for(i=0;i<MUTEX_ENTRIES;i++)
+  {
+    mutex = MutexEntry(i);
+    if ((mutex != NULL) && (mutex->OSEventAllocated == TRUE) && (mutex->OSInheritPriority == iPriority) &&
+        OSWaitListTest(mutex->OSEventWaitList, iTaskNumber, iPriority))
+    {
+      OSEventWaitRemove(&mutex->OSEventWaitList, &mutex->OSEventWait, iTaskNumber, iPriority);
+      OSMutexInherit(mutex, mutex->OSEventOwner);
+    }
+  }
+  #else
+  // The priority of a task waiting for a mutex may be lent to the mutex owner.
+  // The owner gives it back before the priority is released.
+  for(i=0;i<MUTEX_ENTRIES;i++)
+  {
+    mutex = MutexEntry(i);
+    if ((mutex != NULL) && (mutex->OSEventAllocated == TRUE) && (mutex->OSInheritPriority == iPriority))
+    {
+      OSEventWaitRemove(&mutex->OSEventWaitList, &mutex->OSEventWait, iTaskNumber, iPriority);
+      mutex->OSInheritTask = EMPTY_PRIO;
+      OSMutexInherit(mutex, mutex->OSEventOwner);
+      
+      // An owner waiting for other event keeps the priority
+      if (mutex->OSInheritPriority == iPriority)
+      {
+        mutex->OSInheritTask = iTaskNumber;
+        PrioListAdd(mutex->OSEventWaitList, iPriority);
+        mutex->OSEventWait++;
+        
+        // Exit critical Section
+        if (currentTask)
+          OSExitCritical();
+        return BUSY_PRIORITY;
+      }
+    }
+  }
+  #endif
+  #endif
+  
+  // Remove the task from the ready list and from the blocked list
+  OSReadyListRemove(iTaskNumber, iPriority);
+  OSReadyListUnblock(iTaskNumber, iPriority);
+  
+  // Remove the task from the delay list
+  Search = Head;
+  while ((Search != NULL) && (Search != Task))
+  {
+    Search = Search->Next;
+  }
+  
+  if (Search == Task)
+  {
+    RemoveFromDelayList();
+  }
+  
+  // Remove the task from the event wait lists
+  #if (BRTOS_SEM_EN == 1)
+  for(i=0;i<SEM_ENTRIES;i++)
+  {
+    sem = SemEntry(i);
+    if (sem != NULL)
+    {
+      OSEventWaitRemove(&sem->OSEventWaitList, &sem->OSEventWait, iTaskNumber, iPriority);
+    }
+  }
+  #endif
+  
+  #if (BRTOS_MUTEX_EN == 1)
+  for(i=0;i<MUTEX_ENTRIES;i++)
+  {
+    mutex = MutexEntry(i);
+    if (mutex != NULL)
+    {
+      OSEventWaitRemove(&mutex->OSEventWaitList, &mutex->OSEventWait, iTaskNumber, iPriority);
+    }
+  }
+  #endif
+  
+  #if (BRTOS_MBOX_EN == 1)
+  for(i=0;i<MBOX_ENTRIES;i++)
+  {
+    mbox = MboxEntry(i);
+    if (mbox != NULL)
+    {
+      OSEventWaitRemove(&mbox->OSEventWaitList, &mbox->OSEventWait, iTaskNumber, iPriority);
+      #if (BRTOS_POST_WAIT_EN == 1)
+      OSEventWaitRemove(&mbox->OSEventSendWaitList, &mbox->OSEventSendWait, iTaskNumber, iPriority);
+      
+      // The message slot kept to the task goes to the next sender
+      if (Task->Reservation == (void*)mbox)
+      {
+        if (OSReservationTransfer(&mbox->OSEventSendWaitList, &mbox->OSEventSendWait, mbox) == TRUE)
+        {
+          woken = TRUE;
+        }
+        else
+        {
+          mbox->OSEventSendReserved = FALSE;
+        }
+      }
+      #endif
+    }
+  }
+  #endif
+  
+  #if (BRTOS_QUEUE_EN == 1)
+  for(i=0;i<QUEUE_ENTRIES;i++)
+  {
+    queue = QueueEntry(i);
+    if (queue != NULL)
+    {
+      OSEventWaitRemove(&queue->OSEventWaitList, &queue->OSEventWait, iTaskNumber, iPriority);
+      #if (BRTOS_POST_WAIT_EN == 1)
+      OSEventWaitRemove(&queue->OSEventSendWaitList, &queue->OSEventSendWait, iTaskNumber, iPriority);
+      
+      // The queue slot kept to the task goes to the next sender
+      if (Task->Reservation == (void*)queue)
+      {
+        if (OSReservationTransfer(&queue->OSEventSendWaitList, &queue->OSEventSendWait, queue) == TRUE)
+        {
+          woken = TRUE;
+        }
+        else
+        {
+          queue->OSEventSendReserved--;
+        }
+      }
+      #endif
+    }
+  }
+  #endif
+  
+  #if (BRTOS_MEMPOOL_EN == 1)
+  for(i=0;i<BRTOS_MAX_MEMPOOL;i++)
+  {
+    OSEventWaitRemove(&BRTOS_MemPool_Table[i].OSEventWaitList, &BRTOS_MemPool_Table[i].OSEventWait, iTaskNumber, iPriority);
+    
+    #if (TASK_RESERVATION_EN == 1)
+    // The block kept to the task goes to the next waiting task
+    if (Task->Reservation == (void*)&BRTOS_MemPool_Table[i])
+    {
+      if (OSReservationTransfer(&BRTOS_MemPool_Table[i].OSEventWaitList, &BRTOS_MemPool_Table[i].OSEventWait, &BRTOS_MemPool_Table[i]) == TRUE)
+      {
+        woken = TRUE;
+      }
+      else
+      {
+        BRTOS_MemPool_Table[i].OSMemReserved--;
+      }
+    }
+    #endif
+  }
+  #endif
+  
+  #if (BRTOS_FLAG_EN == 1)
+  for(i=0;i<BRTOS_MAX_FLAG;i++)
+  {
+    OSEventWaitRemove(&BRTOS_Flag_Table[i].OSEventWaitList, &BRTOS_Flag_Table[i].OSEventWait, iTaskNumber, iPriority);
+  }
+  #endif
+  
+  #if (BRTOS_STREAM_EN == 1)
+  for(i=0;i<BRTOS_MAX_STREAM;i++)
+  {
+    if (BRTOS_Stream_Table[i].OSStreamWaiter == iTaskNumber)
+    {
+      BRTOS_Stream_Table[i].OSStreamWaiter = 0;
+    }
+  }
+  #endif
+  
+  #if (BRTOS_SET_EN == 1)
+  for(i=0;i<BRTOS_MAX_SET;i++)
+  {
+    OSEventWaitRemove(&BRTOS_Set_Table[i].OSEventWaitList, &BRTOS_Set_Table[i].OSEventWait, iTaskNumber, iPriority);
+  }
+  #endif
+  
+  #if (BRTOS_RWLOCK_EN == 1)
+  for(i=0;i<BRTOS_MAX_RWLOCK;i++)
+  {
+    OSEventWaitRemove(&BRTOS_RWLock_Table[i].OSRWReadWaitList, &BRTOS_RWLock_Table[i].OSRWReadWait, iTaskNumber, iPriority);
+    OSEventWaitRemove(&BRTOS_RWLock_Table[i].OSRWWriteWaitList, &BRTOS_RWLock_Table[i].OSRWWriteWait, iTaskNumber, iPriority);
+  }
+  #endif
+  
+  #if (BRTOS_COND_EN == 1)
+  for(i=0;i<BRTOS_MAX_COND;i++)
+  {
+    OSEventWaitRemove(&BRTOS_Cond_Table[i].OSEventWaitList, &BRTOS_Cond_Table[i].OSEventWait, iTaskNumber, iPriority);
+  }
+  #endif
+  
+  #if (BRTOS_BARRIER_EN == 1)
+  for(i=0;i<BRTOS_MAX_BARRIER;i++)
+  {
+    OSEventWaitRemove(&BRTOS_Barrier_Table[i].OSEventWaitList, &BRTOS_Barrier_Table[i].OSEventWait, iTaskNumber, iPriority);
+  }
+  #endif
+  
+  // Release the priority
+  #if (ROUND_ROBIN_EN == 1)
+  // A shared priority is released by the last task that uses it
+  PriorityTasks[iPriority]--;
+  Task->WaitList = NULL;
+  
+  if (PriorityTasks[iPriority] == 0)
+  {
+    PriorityVector[iPriority] = EMPTY_PRIO;
+  }
+  else
+  {
+    if (PriorityVector[iPriority] == iTaskNumber)
+    {
+      // Other task of the priority occupies it
+      for (i = 1; i <= NUMBER_OF_TASKS; i++)
+      {
+        if ((i != iTaskNumber) && (ContextTask[i].Priority == iPriority) &&
+            (TaskAlloc[(i - 1) >> 5] & ((INT32U)1 << ((i - 1) & 0x1F))))
+        {
+          PriorityVector[iPriority] = i;
+          break;
+        }
+      }
+    }
+  }
+  #else
+  PriorityVector[iPriority] = EMPTY_PRIO;
+  #endif
+  
+  // Release the task control block
+  i = (INT8U)(iTaskNumber - 1);
+  TaskAlloc[i >> 5] = TaskAlloc[i >> 5] & ~((INT32U)1 << (i & 0x1F));
+  NumberOfInstalledTasks--;
+  
+  // Release the task stack
+  OSStackRelease(Task->StackIndex, Task->StackWords);
+  
+  #if (VERBOSE == 1)
+  Task->State = SUSPENDED;
+  #endif
+  
+  #if (TASK_RESERVATION_EN == 1)
+  Task->Reservation = NULL;
+  #endif
+  
+  #if (TASK_NOTIFY_EN == 1)
+  // Notifications sent to the deleted task are discarded
+  Task->NotifyValue = 0;
+  Task->NotifyState = NOTIFY_NONE;
+  #endif
+  
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+  // A task that deletes itself releases the scheduler lock it holds
+  if (currentTask == iTaskNumber)
+  {
+    OSSchedLockNesting = 0;
+  }
+  #endif
+  
+  // The task deleted itself, or other task received the slot kept to the deleted task
+  if ((currentTask == iTaskNumber) || (currentTask && (woken == TRUE)))
+  {
+     ChangeContext();
+  }
+  
+  // Exit critical Section
+  if (currentTask)
+    OSExitCritical();
+  
+  return OK;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
 
-   // Posiciona o inicio do stack da tarefa
-   // no inicio da disponibilidade de RAM do HEAP
-	#if STACK_GROWTH == 1
-	 Task->StackPoint = StackAddress + NUMBER_MIN_OF_STACKED_BYTES;
-	#else
-	 Task->StackPoint = StackAddress + (USER_STACKED_BYTES - NUMBER_MIN_OF_STACKED_BYTES);
+
+
+
+#if (STACK_WATERMARK_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Stack Watermark Functions                   /////
+/////                                                  /////
+/////  The stacks are painted at task install. The     /////
+/////  idle task counts the painted words from the     /////
+/////  stack end, a few words at a time.               /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+static void OSStackPaint(ContextType *Task)
+{
+  INT16U i;
+  
+  for(i=0;i<Task->StackWords;i++)
+  {
+    STACK[Task->StackIndex + i] = STACK_PAINT_PATTERN;
+  }
+  
+  Task->StackUntouched = Task->StackWords;
+  
+  // Restart the verification of a reused task control block
+  if (&ContextTask[OSWatermarkTask] == Task)
+  {
+    OSWatermarkCursor = 0;
+  }
+}
+
+
+
+void OSStackWatermarkUpdate(void)
+{
+  OS_SR_SAVE_VAR
+  ContextType *Task;
+  OS_CPU_TYPE word;
+  INT16U i;
+  INT8U  j;
+  INT8U  done = FALSE;
+  
+  // Enter critical Section
+  OSEnterCritical();
+  
+  Task = &ContextTask[OSWatermarkTask];
+  
+  for(i=0;i<STACK_WATERMARK_STEP;i++)
+  {
+    if (OSWatermarkCursor >= Task->StackUntouched)
+    {
+      done = TRUE;
+      break;
+    }
+    
+    // The stack end is the last position that the task can use
+    #if STACK_GROWTH == 1
+    word = STACK[Task->StackIndex + Task->StackWords - 1 - OSWatermarkCursor];
+    #else
+    word = STACK[Task->StackIndex + OSWatermarkCursor];
+    #endif
+    
+    if (word != STACK_PAINT_PATTERN)
+    {
+      Task->StackUntouched = OSWatermarkCursor;
+      done = TRUE;
+      break;
+    }
+    
+    OSWatermarkCursor++;
+  }
+  
+  if (done == TRUE)
+  {
+    // Next installed task. The idle task is the last one.
+    OSWatermarkCursor = 0;
+    do
+    {
+      OSWatermarkTask++;
+      if (OSWatermarkTask > (NUMBER_OF_TASKS + 1))
+      {
+        OSWatermarkTask = 1;
+      }
+      j = (INT8U)(OSWatermarkTask - 1);
+    }while((OSWatermarkTask <= NUMBER_OF_TASKS) && !(TaskAlloc[j >> 5] & ((INT32U)1 << (j & 0x1F))));
+  }
+  
+  // Exit critical Section
+  OSExitCritical();
+}
+
+
+
+INT16U OSTaskStackHighWater(BRTOS_TH iTaskNumber)
+{
+  OS_SR_SAVE_VAR
+  INT16U used;
+  
+  if ((iTaskNumber == 0) || (iTaskNumber > (NUMBER_OF_TASKS + 1)))
+  {
+     return 0;
+  }
+  
+  // Enter critical Section
+  if (currentTask)
+    OSEnterCritical();
+  
+  used = (INT16U)((ContextTask[iTaskNumber].StackWords - ContextTask[iTaskNumber].StackUntouched) * sizeof(OS_CPU_TYPE));
+  
+  // Exit critical Section
+  if (currentTask)
+    OSExitCritical();
+  
+  return used;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
+
+
+
+#if (TASK_NOTIFY_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Task Notification Functions                 /////
+/////                                                  /////
+/////  Each task has a notification word. A notify     /////
+/////  updates the word and releases the task if it    /////
+/////  is waiting, without any event control block.    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSTaskNotify(BRTOS_TH iTaskNumber, INT32U value, INT8U action)
+{
+  OS_SR_SAVE_VAR
+  INT8U i;
+  ContextType *Task;
+  
+  #if (ERROR_CHECK == 1)
+    // The idle task does not receive notifications
+    if ((iTaskNumber == 0) || (iTaskNumber > NUMBER_OF_TASKS))
+    {
+       return NOT_VALID_TASK;
+    }
   #endif
-                                                                      
-  // Virtual Stack Init
-	#if STACK_GROWTH == 1
-	Task->StackInit = StackAddress;
-	#else
-	Task->StackInit = StackAddress + USER_STACKED_BYTES;
-	#endif
+  
+  Task = (ContextType*)&ContextTask[iTaskNumber];
+  
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+  
+  // A deleted or not installed task does not receive notifications
+  i = (INT8U)(iTaskNumber - 1);
+  if (!(TaskAlloc[i >> 5] & ((INT32U)1 << (i & 0x1F))))
+  {
+     // Exit Critical Section
+     #if (NESTING_INT == 0)
+     if (!iNesting)
+     #endif
+        OSExitCritical();
+     return NOT_VALID_TASK;
+  }
+  
+  switch(action)
+  {
+    case NOTIFY_SET_BITS:
+      Task->NotifyValue |= value;
+      break;
+    case NOTIFY_INCREMENT:
+      Task->NotifyValue++;
+      break;
+    case NOTIFY_OVERWRITE:
+      Task->NotifyValue = value;
+      break;
+    default:
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return INVALID_PARAMETERS;
+  }
+  
+  if (Task->NotifyState == NOTIFY_WAITING)
+  {
+    // Put the task into Ready List
+    #if (VERBOSE == 1)
+    Task->State = READY;
+    #endif
     
+    OSReadyListAdd(iTaskNumber, Task->Priority);
+    Task->NotifyState = NOTIFY_PENDING;
+    
+    // If outside of an interrupt service routine, change context to the highest priority task
+    // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+    if (!iNesting)
+    {
+      ChangeContext();
+    }
+  }
+  else
+  {
+    Task->NotifyState = NOTIFY_PENDING;
+  }
+  
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+  
+  return OK;
+}
 
-   // Determina a prioridade da funo
-   Task->Priority = iPriority;
 
-   // Determina a tarefa que ir ocupar esta prioridade
-   PriorityVector[iPriority] = TaskNumber;
-   // set the function entry address in the context
-   
-   // Fill the virtual task stack
-   #if (TASK_WITH_PARAMETERS == 1)
-      CreateVirtualStack(FctPtr, USER_STACKED_BYTES, parameters);
-   #else
-      CreateVirtualStack(FctPtr, USER_STACKED_BYTES);   
-   #endif
-   
-   // Incrementa o contador de bytes do stack virtual (HEAP)
-   iStackAddress = iStackAddress + (USER_STACKED_BYTES / sizeof(OS_CPU_TYPE));
-   
-   // Posiciona o endereo de stack virtual p/ a prxima tarefa instalada
-   StackAddress = StackAddress + USER_STACKED_BYTES;
-   
 
-   Task->TimeToWait = NO_TIMEOUT;
-   Task->Next     =  NULL;
-   Task->Previous =  NULL;
-   
-   #if (VERBOSE == 1)
-   Task->Blocked = FALSE;
-   Task->State = READY;
-   #endif   
-   
-   OSReadyList = OSReadyList | (PriorityMask[iPriority]);   
-   
-   if (currentTask)
+INT8U OSTaskNotifyWait(INT32U *value, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U  iPriority;
+  ContextType *Task;
+  
+  #if (ERROR_CHECK == 1)
+    // Can not use notification wait function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+  
+  Task = (ContextType*)&ContextTask[currentTask];
+  
+  // Enter Critical Section
+  OSEnterCritical();
+  
+  if (Task->NotifyState != NOTIFY_PENDING)
+  {
+    // Copy task priority to local scope
+    iPriority = Task->Priority;
+    
+    Task->NotifyState = NOTIFY_WAITING;
+    
+    // Task entered suspended state, waiting for a notification
+    #if (VERBOSE == 1)
+    Task->State = SUSPENDED;
+    Task->SuspendedType = NOTIFICATION;
+    #endif
+    
+    // Remove current task from the Ready List
+    OSReadyListRemove(currentTask, iPriority);
+    
+    // Set timeout overflow
+    if (time_wait)
+    {
+      Task->TimeToWait = OSWakeTimeCompute(time_wait);
+      
+      // Put task into delay list
+      IncludeTaskIntoDelayList();
+    } else
+    {
+      Task->TimeToWait = NO_TIMEOUT;
+    }
+    
+    // Change Context - Returns on time overflow or notification
+    ChangeContext();
+    
     // Exit Critical Section
-    OSExitCritical();   
-   
-   return OK;
+    OSExitCritical();
+    // Enter Critical Section
+    OSEnterCritical();
+    
+    if (time_wait)
+    {
+        // Verify if the reason of task wake up was timeout
+        if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+        {
+            // Test if both timeout and notification have occured before arrive here
+            if (Task->NotifyState == NOTIFY_WAITING)
+            {
+              Task->NotifyState = NOTIFY_NONE;
+              
+              // Exit Critical Section
+              OSExitCritical();
+              
+              // Indicates notification timeout
+              return TIMEOUT;
+            }
+        }
+        else
+        {
+            // Remove the time to wait condition
+            Task->TimeToWait = NO_TIMEOUT;
+            
+            // Remove from delay list
+            RemoveFromDelayList();
+        }
+    }
+  }
+  
+  // Takes the notification word
+  if (value != NULL)
+  {
+    *value = Task->NotifyValue;
+  }
+  Task->NotifyValue = 0;
+  Task->NotifyState = NOTIFY_NONE;
+  
+  // Exit Critical Section
+  OSExitCritical();
+  
+  return OK;
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
+#endif
 
 
 
@@ -1176,6 +2935,12 @@ INT8U UnBlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
 	ContextTask[NUMBER_OF_TASKS+1].StackInit = StackAddress + USER_STACKED_BYTES;
 	#endif
 
+   #if (STACK_WATERMARK_EN == 1)
+   ContextTask[NUMBER_OF_TASKS+1].StackIndex = iStackAddress;
+   ContextTask[NUMBER_OF_TASKS+1].StackWords = USER_STACKED_BYTES / sizeof(OS_CPU_TYPE);
+   OSStackPaint(&ContextTask[NUMBER_OF_TASKS+1]);
+   #endif
+
    // Determina a prioridade da funo
    ContextTask[NUMBER_OF_TASKS+1].Priority = 0;
    // Determina a tarefa que ir ocupar esta prioridade
@@ -1201,7 +2966,12 @@ INT8U UnBlockMultipleTask(INT8U TaskStart, INT8U TaskNumber)
    ContextTask[NUMBER_OF_TASKS+1].State = READY;  
    #endif
    
-   OSReadyList = OSReadyList | (PriorityType)1;
+   #if (ROUND_ROBIN_EN == 1)
+   ContextTask[NUMBER_OF_TASKS+1].ReadyState = 0;
+   ContextTask[NUMBER_OF_TASKS+1].WaitList = NULL;
+   #endif
+   
+   OSReadyListAdd(NUMBER_OF_TASKS+1, 0);
    
    if (currentTask)
     // Exit Critical Section
@@ -1246,6 +3016,17 @@ void initEvents(void)
 {
   INT8U i=0;
   
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+    // All the pool entries are linked into the free list
+    for(i=0;i<BRTOS_MAX_OBJECTS;i++)
+    {
+      BRTOS_Object_Table[i].OSEventAllocated = 0;
+      BRTOS_Object_Type[i] = OBJECT_FREE;
+      BRTOS_Object_Gen[i] = 0;
+      OSObjectNext[i] = (INT8U)(i + 1);
+    }
+    OSObjectFreeList = 0;
+  #else
   #if (BRTOS_SEM_EN == 1)
     for(i=0;i<BRTOS_MAX_SEM;i++)
       BRTOS_Sem_Table[i].OSEventAllocated = 0;
@@ -1265,12 +3046,190 @@ void initEvents(void)
     for(i=0;i<BRTOS_MAX_QUEUE;i++)
       BRTOS_Queue_Table[i].OSEventAllocated = 0;    
   #endif
+  #endif
+  
+  #if (BRTOS_MEMPOOL_EN == 1)
+    for(i=0;i<BRTOS_MAX_MEMPOOL;i++)
+      BRTOS_MemPool_Table[i].OSEventAllocated = 0;
+  #endif
+  
+  #if (BRTOS_FLAG_EN == 1)
+    for(i=0;i<BRTOS_MAX_FLAG;i++)
+      BRTOS_Flag_Table[i].OSEventAllocated = 0;
+  #endif
+  
+  #if (BRTOS_STREAM_EN == 1)
+    for(i=0;i<BRTOS_MAX_STREAM;i++)
+    {
+      BRTOS_Stream_Table[i].OSEventAllocated = 0;
+      BRTOS_Stream_Table[i].OSStreamWaiter = 0;
+    }
+  #endif
+  
+  #if (BRTOS_SET_EN == 1)
+    for(i=0;i<BRTOS_MAX_SET;i++)
+      BRTOS_Set_Table[i].OSEventAllocated = 0;
+  #endif
+  
+  #if (BRTOS_RWLOCK_EN == 1)
+    for(i=0;i<BRTOS_MAX_RWLOCK;i++)
+      BRTOS_RWLock_Table[i].OSEventAllocated = 0;
+  #endif
+  
+  #if (BRTOS_COND_EN == 1)
+    for(i=0;i<BRTOS_MAX_COND;i++)
+      BRTOS_Cond_Table[i].OSEventAllocated = 0;
+  #endif
+  
+  #if (BRTOS_BARRIER_EN == 1)
+    for(i=0;i<BRTOS_MAX_BARRIER;i++)
+      BRTOS_Barrier_Table[i].OSEventAllocated = 0;
+  #endif
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+#if (BRTOS_OBJECT_POOL_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Shared Object Pool Functions                /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+void *OSObjectAlloc(INT8U type)
+{
+  INT8U i = OSObjectFreeList;
+  
+  // The free list ends with BRTOS_MAX_OBJECTS
+  if (i >= BRTOS_MAX_OBJECTS)
+  {
+    return NULL;
+  }
+  
+  OSObjectFreeList = OSObjectNext[i];
+  BRTOS_Object_Type[i] = type;
+  BRTOS_Object_Table[i].OSEventAllocated = TRUE;
+  
+  return (void*)&BRTOS_Object_Table[i];
+}
+
+
+
+void OSObjectFree(void *object)
+{
+  INT8U i = (INT8U)((BRTOS_Object*)object - BRTOS_Object_Table);
+  
+  // A control block deleted twice is not inserted twice into the free list
+  if (BRTOS_Object_Type[i] == OBJECT_FREE)
+  {
+    return;
+  }
+  
+  BRTOS_Object_Type[i] = OBJECT_FREE;
+  BRTOS_Object_Table[i].OSEventAllocated = 0;
+  
+  // The handles of the deleted object become stale
+  BRTOS_Object_Gen[i]++;
+  
+  OSObjectNext[i] = OSObjectFreeList;
+  OSObjectFreeList = i;
+}
+
+
+
+void *OSObjectGet(INT8U type, INT8U index)
+{
+  if (BRTOS_Object_Type[index] != type)
+  {
+    return NULL;
+  }
+  
+  return (void*)&BRTOS_Object_Table[index];
+}
+
+
+
+INT8U OSObjectCheck(void *object, INT8U type)
+{
+  BRTOS_Object *entry = (BRTOS_Object*)object;
+  
+  if ((entry < BRTOS_Object_Table) || (entry >= &BRTOS_Object_Table[BRTOS_MAX_OBJECTS]))
+  {
+    return FALSE;
+  }
+  
+  // A stale pointer may reach an entry that was reused by another object type
+  if (BRTOS_Object_Type[entry - BRTOS_Object_Table] != type)
+  {
+    return FALSE;
+  }
+  
+  return (INT8U)(entry->OSEventAllocated == TRUE);
+}
+
+
+
+BRTOS_Handle OSObjectHandle(void *object)
+{
+  BRTOS_Object *entry = (BRTOS_Object*)object;
+  INT8U i;
+  
+  if ((entry < BRTOS_Object_Table) || (entry >= &BRTOS_Object_Table[BRTOS_MAX_OBJECTS]))
+  {
+    return OBJECT_INVALID_HANDLE;
+  }
+  
+  i = (INT8U)(entry - BRTOS_Object_Table);
+  
+  return (BRTOS_Handle)(((BRTOS_Handle)BRTOS_Object_Gen[i] << 8) | i);
+}
+
+
+
+void *OSObjectResolve(BRTOS_Handle handle, INT8U type)
+{
+  OS_SR_SAVE_VAR
+  INT8U i = (INT8U)(handle & 0xFF);
+  void  *object = NULL;
+  
+  if (i >= BRTOS_MAX_OBJECTS)
+  {
+    return NULL;
+  }
+  
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+  
+  // The entry may hold a new object of the same type
+  if ((BRTOS_Object_Gen[i] == (INT8U)(handle >> 8)) && OSObjectCheck(&BRTOS_Object_Table[i], type))
+  {
+    object = (void*)&BRTOS_Object_Table[i];
+  }
+  
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+  
+  return object;
 }
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
+#endif
 
 
 
@@ -1280,16 +3239,94 @@ void initEvents(void)
 /////    Sucessive Aproximation Scheduler Algorithm    /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-#if (OPTIMIZED_SCHEDULER == 1)
+#if (OPTIMIZED_SCHEDULER == SCHED_HAL)
 
-INT8U SAScheduler(PriorityType READY_LIST_VAR)
+INT8U SAScheduler(PriorityBits READY_LIST_VAR)
 {
   Optimezed_Scheduler();
 }
 
+#elif (OPTIMIZED_SCHEDULER == SCHED_BUILTIN_CLZ)
+
+INT8U SAScheduler(PriorityBits ReadyList)
+{
+  // __builtin_clzl is undefined for zero
+  if (ReadyList == 0)
+  {
+    return 0;
+  }
+  
+  return (INT8U)(((sizeof(unsigned long) * 8) - 1) - __builtin_clzl((unsigned long)ReadyList));
+}
+
+#elif (OPTIMIZED_SCHEDULER == SCHED_LOOKUP_TABLE)
+
+// Highest bit set of each byte value
+static const INT8U SAHighestBit[256] =
+{
+  0,0,1,1,2,2,2,2,3,3,3,3,3,3,3,3,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+  5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
+  6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
+  6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
+  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7
+};
+
+INT8U SAScheduler(PriorityBits ReadyList)
+{
+  #if (PRIORITY_BITS > 16)
+  if (ReadyList > 0xFFFF)
+  {
+    if (ReadyList > 0xFFFFFF)
+    {
+      return (INT8U)(24 + SAHighestBit[(INT8U)(ReadyList >> 24)]);
+    }
+    return (INT8U)(16 + SAHighestBit[(INT8U)(ReadyList >> 16)]);
+  }
+  #endif
+  
+  #if (PRIORITY_BITS > 8)
+  if (ReadyList > 0xFF)
+  {
+    return (INT8U)(8 + SAHighestBit[(INT8U)(ReadyList >> 8)]);
+  }
+  #endif
+  
+  return SAHighestBit[(INT8U)ReadyList];
+}
+
+#elif (OPTIMIZED_SCHEDULER == SCHED_DE_BRUIJN)
+
+// Bit position of each 2^n - 1 value, indexed by its de Bruijn hash
+static const INT8U SADeBruijn[32] =
+{
+  0, 9, 1,10,13,21, 2,29,11,14,16,18,22,25, 3,30,
+  8,12,20,28,15,17,24, 7,19,27,23, 6,26, 5, 4,31
+};
+
+INT8U SAScheduler(PriorityBits ReadyList)
+{
+  INT32U list = (INT32U)ReadyList;
+  
+  // Set all the bits below the highest bit set
+  list |= list >> 1;
+  list |= list >> 2;
+  list |= list >> 4;
+  #if (PRIORITY_BITS > 8)
+  list |= list >> 8;
+  #endif
+  #if (PRIORITY_BITS > 16)
+  list |= list >> 16;
+  #endif
+  
+  return SADeBruijn[((list * 0x07C4ACDDUL) >> 27) & 0x1F];
+}
+
 #else
 
-INT8U SAScheduler(PriorityType ReadyList)
+INT8U SAScheduler(PriorityBits ReadyList)
 {
   INT8U prio = 0;
   
@@ -1524,3 +3561,110 @@ INT8U SAScheduler(PriorityType ReadyList)
 }
 
 #endif
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+#if (NUMBER_OF_PRIORITIES > 32)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Two-Level Priority List Functions           /////
+/////                                                  /////
+/////  The group bitmap selects the highest group with /////
+/////  at least one priority and the group word selects/////
+/////  the priority. Both searches use SAScheduler.    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+void OSPrioListInit(PriorityType *list)
+{
+  INT8U i;
+  
+  list->Group = 0;
+  for(i=0;i<PRIORITY_GROUPS;i++)
+  {
+    list->Bits[i] = 0;
+  }
+}
+
+
+
+void OSPrioListAdd(PriorityType *list, INT8U iPriority)
+{
+  INT8U group = PRIORITY_GROUP(iPriority);
+  
+  list->Bits[group] = list->Bits[group] | PriorityMask[PRIORITY_BIT(iPriority)];
+  list->Group = list->Group | (INT8U)PriorityMask[group];
+}
+
+
+
+void OSPrioListRemove(PriorityType *list, INT8U iPriority)
+{
+  INT8U group = PRIORITY_GROUP(iPriority);
+  
+  list->Bits[group] = list->Bits[group] & ~(PriorityMask[PRIORITY_BIT(iPriority)]);
+  
+  if (list->Bits[group] == 0)
+  {
+    list->Group = list->Group & (INT8U)~(PriorityMask[group]);
+  }
+}
+
+
+
+void OSPrioListMerge(PriorityType *list, PriorityType *src)
+{
+  INT8U i;
+  
+  for(i=0;i<PRIORITY_GROUPS;i++)
+  {
+    list->Bits[i] = list->Bits[i] | src->Bits[i];
+  }
+  list->Group = list->Group | src->Group;
+}
+
+
+
+INT8U OSPrioListHighest(PriorityType *list)
+{
+  INT8U group = SAScheduler(list->Group);
+  
+  return (INT8U)((group << 5) + SAScheduler(list->Bits[group]));
+}
+
+
+
+INT8U OSPrioListHighestReady(void)
+{
+  INT8U groups = OSReadyList.Group;
+  INT8U group;
+  PriorityBits ready;
+  
+  // Blocked priorities are rare. Only the groups that have ready but
+  // blocked priorities are skipped, at most PRIORITY_GROUPS times.
+  while (groups)
+  {
+    group = SAScheduler(groups);
+    ready = OSReadyList.Bits[group] & OSBlockedList.Bits[group];
+    
+    if (ready)
+    {
+      return (INT8U)((group << 5) + SAScheduler(ready));
+    }
+    
+    groups = groups & (INT8U)~(PriorityMask[group]);
+  }
+  
+  // The idle task is always ready
+  return 0;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
@@ -70,11 +70,13 @@ void OSTaskList(char *string)
 {
     INT16U VirtualStack = 0;
     INT8U  j = 0;
-    INT8U  i = 0;
     INT8U  prio = 0;
     CHAR8  str[9];
+    #if (STACK_WATERMARK_EN == 0)
+    INT8U  i = 0;
     INT32U *sp_end = 0;
     INT32U *sp_address = 0;
+    #endif
 
     string += mem_cpy(string,"\n\r******************************************\n\r");
     string += mem_cpy(string,"ID   NAME           PRIORITY   STACK SIZE\n\r");
@@ -113,6 +115,9 @@ void OSTaskList(char *string)
       string += mem_cpy(string,"       ");
 
       // Print the task stack size
+      #if (STACK_WATERMARK_EN == 1)
+      VirtualStack = OSTaskStackHighWater(j);
+      #else
       UserEnterCritical();
       sp_address = (INT32U*)ContextTask[j].StackPoint;
       if (j == 1)
@@ -146,6 +151,7 @@ void OSTaskList(char *string)
       UserEnterCritical();
       VirtualStack = ContextTask[j].StackInit - ((INT32U)sp_address + (i*4));
       UserExitCritical();
+      #endif
 
       (void)PrintDecimal(VirtualStack, str);
       string += mem_cpy(string, str);
@@ -173,6 +179,9 @@ void OSTaskList(char *string)
     string += mem_cpy(string, (str+2));
     string += mem_cpy(string,"       ");
 
+    #if (STACK_WATERMARK_EN == 1)
+    VirtualStack = OSTaskStackHighWater(NUMBER_OF_TASKS+1);
+    #else
     UserEnterCritical();
     sp_address = (INT32U*)ContextTask[NUMBER_OF_TASKS+1].StackPoint;
     sp_end = (INT32U*)ContextTask[j-1].StackInit;
@@ -199,6 +208,7 @@ void OSTaskList(char *string)
     UserEnterCritical();
     VirtualStack = ContextTask[NUMBER_OF_TASKS+1].StackInit - ((INT32U)sp_address + (INT32U)i*4);
     UserExitCritical();
+    #endif
 
     (void)PrintDecimal(VirtualStack, str);
     string += mem_cpy(string, str);
@@ -0,0 +1,317 @@
+/**
+* \file barrier.c
+* \brief BRTOS Barrier functions
+*
+* Functions to install and use barriers
+*
+**/
+/*********************************************************************************************************
+*                                               BRTOS
+*                                Brazilian Real-Time Operating System
+*                            Acronymous of Basic Real-Time Operating System
+*
+*
+*                                  Open Source RTOS under MIT License
+*
+*
+*
+*                                       OS Barrier functions
+*
+*
+*   Revision: 1.80
+*   Date:     17/10/2026
+*
+*  A barrier synchronizes a group of tasks. Each task of the group calls
+*  OSBarrierWait() at the end of a phase. The last task to arrive releases
+*  all the others with one ready list update and one context switch. The
+*  barrier may be used again right away, and each release increments the
+*  barrier generation.
+*
+*********************************************************************************************************/
+
+#include "BRTOS.h"
+
+#if (PROCESSOR == COLDFIRE_V1)
+#pragma warn_implicitconv off
+#endif
+
+#if (BRTOS_BARRIER_EN == 1)
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Create Barrier Function                     /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSBarrierCreate (INT8U count, BRTOS_Barrier **event)
+{
+  OS_SR_SAVE_VAR
+  int i=0;
+
+  BRTOS_Barrier *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be create by interrupt
+  }
+
+  // The group must have at least one task
+  if (count == 0)
+  {
+      return(INVALID_PARAMETERS);
+  }
+
+  // Enter critical Section
+  if (currentTask)
+     OSEnterCritical();
+
+  // Verifies if there is available event control block
+  for(i=0;i<=BRTOS_MAX_BARRIER;i++)
+  {
+
+    if(i >= BRTOS_MAX_BARRIER)
+    {
+      // Exit critical Section
+      if (currentTask)
+         OSExitCritical();
+
+      return(NO_AVAILABLE_EVENT);
+    }
+
+    if(BRTOS_Barrier_Table[i].OSEventAllocated != TRUE)
+    {
+      BRTOS_Barrier_Table[i].OSEventAllocated = TRUE;
+      pont_event = &BRTOS_Barrier_Table[i];
+      break;
+    }
+  }
+
+  pont_event->OSBarrierCount      = count;
+  pont_event->OSBarrierGeneration = 0;
+  pont_event->OSEventWait         = 0;
+
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = pont_event;
+
+  // Exit critical Section
+  if (currentTask)
+     OSExitCritical();
+
+  return(ALLOC_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Delete Barrier Function                     /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSBarrierDelete (BRTOS_Barrier **event)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_Barrier *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be delete by interrupt
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  pont_event = *event;
+  pont_event->OSEventAllocated    = 0;
+  pont_event->OSBarrierCount      = 0;
+  pont_event->OSBarrierGeneration = 0;
+  pont_event->OSEventWait         = 0;
+
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = NULL;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return(DELETE_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Barrier Wait Function                       /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSBarrierWait (BRTOS_Barrier *pont_event, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U  iPriority = 0;
+  INT8U  ret = OK;
+  #if (VERBOSE == 1) && (ROUND_ROBIN_EN == 0)
+  INT16U i;
+  #endif
+  ContextType *Task;
+
+  #if (ERROR_CHECK == 1)
+    // Can not use barrier wait function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // See if the current task is the last one of the group
+  if ((INT16U)(pont_event->OSEventWait + 1) >= pont_event->OSBarrierCount)
+  {
+    // Starts a new generation of the barrier
+    pont_event->OSBarrierGeneration++;
+
+    if (pont_event->OSEventWait != 0)
+    {
+      // Indicates that the waiting tasks are ready to run
+      // The round-robin wait lists update the state of each released task
+      #if (VERBOSE == 1) && (ROUND_ROBIN_EN == 0)
+      for (i = 0; i <= configMAX_TASK_PRIORITY; i++)
+      {
+        if (PrioListTest(pont_event->OSEventWaitList, i))
+        {
+          ContextTask[PriorityVector[i]].State = READY;
+        }
+      }
+      #endif
+
+      // Put all the waiting tasks into the Ready List at once
+      OSWaitListWakeAll(pont_event->OSEventWaitList);
+      pont_event->OSEventWait = 0;
+
+      // Change context to the highest priority task of the group
+      ChangeContext();
+    }
+
+    // Exit Critical Section
+    OSExitCritical();
+    return OK;
+  }
+
+  Task = (ContextType*)&ContextTask[currentTask];
+
+  // Copy task priority to local scope
+  iPriority = Task->Priority;
+  // Increases the barrier wait list counter
+  pont_event->OSEventWait++;
+
+  // Allocates the current task on the barrier wait list
+  OSWaitListAdd(pont_event->OSEventWaitList, currentTask, iPriority);
+
+  // Task entered suspended state, waiting for the other tasks of the group
+  #if (VERBOSE == 1)
+  Task->State = SUSPENDED;
+  Task->SuspendedType = BARRIER;
+  #endif
+
+  // Remove current task from the Ready List
+  OSReadyListRemove(currentTask, iPriority);
+
+  // Set timeout overflow
+  if (time_wait)
+  {
+    Task->TimeToWait = OSWakeTimeCompute(time_wait);
+
+    // Put task into delay list
+    IncludeTaskIntoDelayList();
+  } else
+  {
+    Task->TimeToWait = NO_TIMEOUT;
+  }
+
+  // Change Context - Returns on time overflow or when the last task arrives
+  ChangeContext();
+
+  if (time_wait)
+  {
+      // Exit Critical Section
+      OSExitCritical();
+      // Enter Critical Section
+      OSEnterCritical();
+
+      // Verify if the reason of task wake up was timeout
+      if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+      {
+          // Test if both timeout and barrier release have occured before arrive here
+          if (OSWaitListTest(pont_event->OSEventWaitList, currentTask, iPriority))
+          {
+            // The task leaves the group of the current generation
+            OSWaitListRemove(pont_event->OSEventWaitList, currentTask, iPriority);
+
+            // Decreases the barrier wait list counter
+            pont_event->OSEventWait--;
+
+            // Indicates timeout
+            ret = TIMEOUT;
+          }
+      }
+      else
+      {
+          // Remove the time to wait condition
+          Task->TimeToWait = NO_TIMEOUT;
+
+          // Remove from delay list
+          RemoveFromDelayList();
+      }
+  }
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return ret;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,473 @@
+/**
+* \file cond.c
+* \brief BRTOS Condition Variable functions
+*
+* Functions to install and use condition variables
+*
+**/
+/*********************************************************************************************************
+*                                               BRTOS
+*                                Brazilian Real-Time Operating System
+*                            Acronymous of Basic Real-Time Operating System
+*
+*
+*                                  Open Source RTOS under MIT License
+*
+*
+*
+*                                  OS Condition Variable functions
+*
+*
+*   Revision: 1.80
+*   Date:     17/10/2026
+*
+*  A condition variable is used with a mutex. The waiting task releases the
+*  mutex and blocks in the same critical section, so a signal sent by the
+*  next mutex owner can not be lost. The task acquires the mutex again
+*  before the wait function returns.
+*
+*********************************************************************************************************/
+
+#include "BRTOS.h"
+
+#if (PROCESSOR == COLDFIRE_V1)
+#pragma warn_implicitconv off
+#endif
+
+#if (BRTOS_COND_EN == 1)
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Create Condition Variable Function          /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSCondCreate (BRTOS_Cond **event)
+{
+  OS_SR_SAVE_VAR
+  int i=0;
+
+  BRTOS_Cond *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be create by interrupt
+  }
+
+  // Enter critical Section
+  if (currentTask)
+     OSEnterCritical();
+
+  // Verifies if there is available event control block
+  for(i=0;i<=BRTOS_MAX_COND;i++)
+  {
+
+    if(i >= BRTOS_MAX_COND)
+    {
+      // Exit critical Section
+      if (currentTask)
+         OSExitCritical();
+
+      return(NO_AVAILABLE_EVENT);
+    }
+
+    if(BRTOS_Cond_Table[i].OSEventAllocated != TRUE)
+    {
+      BRTOS_Cond_Table[i].OSEventAllocated = TRUE;
+      pont_event = &BRTOS_Cond_Table[i];
+      break;
+    }
+  }
+
+  pont_event->OSEventWait = 0;
+
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = pont_event;
+
+  // Exit critical Section
+  if (currentTask)
+     OSExitCritical();
+
+  return(ALLOC_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Delete Condition Variable Function          /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSCondDelete (BRTOS_Cond **event)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_Cond *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be delete by interrupt
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  pont_event = *event;
+  pont_event->OSEventAllocated = 0;
+  pont_event->OSEventWait      = 0;
+
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = NULL;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return(DELETE_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Condition Variable Wait Function            /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSCondWait (BRTOS_Cond *pont_event, BRTOS_Mutex *mutex, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U  iPriority = 0;
+  INT8U  ret = OK;
+  #if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+  INT8U  count = 0;
+  #endif
+  ContextType *Task;
+
+  #if (ERROR_CHECK == 1)
+    // Can not use condition variable wait function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+
+    // Verifies if the pointers are NULL
+    if((pont_event == NULL) || (mutex == NULL))
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the condition variable and the mutex are allocated
+    if((pont_event->OSEventAllocated != TRUE) || !OSObjectCreated(mutex, OBJECT_MUTEX))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // The caller must own the mutex that protects the condition
+  if (mutex->OSEventOwner != currentTask)
+  {
+    OSExitCritical();
+    return ERR_EVENT_OWNER;
+  }
+
+  #if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+  // A recursive mutex is released even if it was acquired many times
+  if (mutex->OSRecursive == TRUE)
+  {
+    count = mutex->OSEventCount;
+    mutex->OSEventCount = 0;
+  }
+  #endif
+
+  // Release the mutex - restores the task original priority
+  (void)OSMutexGive(mutex);
+
+  Task = (ContextType*)&ContextTask[currentTask];
+
+  // Copy task priority to local scope
+  iPriority = Task->Priority;
+  // Increases the condition variable wait list counter
+  pont_event->OSEventWait++;
+
+  // Allocates the current task on the condition variable wait list
+  OSWaitListAdd(pont_event->OSEventWaitList, currentTask, iPriority);
+
+  // Task entered suspended state, waiting for a signal
+  #if (VERBOSE == 1)
+  Task->State = SUSPENDED;
+  Task->SuspendedType = CONDITION;
+  #endif
+
+  // Remove current task from the Ready List
+  OSReadyListRemove(currentTask, iPriority);
+
+  // Set timeout overflow
+  if (time_wait)
+  {
+    Task->TimeToWait = OSWakeTimeCompute(time_wait);
+
+    // Put task into delay list
+    IncludeTaskIntoDelayList();
+  } else
+  {
+    Task->TimeToWait = NO_TIMEOUT;
+  }
+
+  // Change Context - Returns on time overflow or signal
+  ChangeContext();
+
+  if (time_wait)
+  {
+      // Exit Critical Section
+      OSExitCritical();
+      // Enter Critical Section
+      OSEnterCritical();
+
+      // Verify if the reason of task wake up was timeout
+      if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+      {
+          // Test if both timeout and signal have occured before arrive here
+          if (OSWaitListTest(pont_event->OSEventWaitList, currentTask, iPriority))
+          {
+            // Remove the task from the condition variable wait list
+            OSWaitListRemove(pont_event->OSEventWaitList, currentTask, iPriority);
+
+            // Decreases the condition variable wait list counter
+            pont_event->OSEventWait--;
+
+            // Indicates timeout
+            ret = TIMEOUT;
+          }
+      }
+      else
+      {
+          // Remove the time to wait condition
+          Task->TimeToWait = NO_TIMEOUT;
+
+          // Remove from delay list
+          RemoveFromDelayList();
+      }
+  }
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  // The task owns the mutex again when it returns, also after a timeout
+  (void)OSMutexAcquire(mutex);
+
+  #if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+  if (mutex->OSRecursive == TRUE)
+  {
+    mutex->OSEventCount = count;
+  }
+  #endif
+
+  return ret;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Condition Variable Signal Function          /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSCondSignal(BRTOS_Cond *pont_event)
+{
+  OS_SR_SAVE_VAR
+  INT8U iPriority = (INT8U)0;
+  INT8U TaskSelect = 0;
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // See if any task is waiting for the condition
+  if (pont_event->OSEventWait != 0)
+  {
+    // Selects the highest priority task
+    iPriority = PrioListHighest(pont_event->OSEventWaitList);
+    TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
+
+    // Remove the selected task from the condition variable wait list
+    OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
+
+    // Decreases the condition variable wait list counter
+    pont_event->OSEventWait--;
+
+    // Indicates that selected task is ready to run
+    #if (VERBOSE == 1)
+    ContextTask[TaskSelect].State = READY;
+    #endif
+
+    // Put the selected task into Ready List
+    OSReadyListAdd(TaskSelect, iPriority);
+
+    // If outside of an interrupt service routine, change context to the highest priority task
+    // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+    if (!iNesting)
+    {
+      ChangeContext();
+    }
+  }
+
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Condition Variable Broadcast Function       /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSCondBroadcast(BRTOS_Cond *pont_event)
+{
+  OS_SR_SAVE_VAR
+  #if (VERBOSE == 1) && (ROUND_ROBIN_EN == 0)
+  INT16U iPriority;
+  #endif
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // See if any task is waiting for the condition
+  if (pont_event->OSEventWait != 0)
+  {
+    // Indicates that the selected tasks are ready to run
+    // The round-robin wait lists update the state of each released task
+    #if (VERBOSE == 1) && (ROUND_ROBIN_EN == 0)
+    for (iPriority = 0; iPriority <= configMAX_TASK_PRIORITY; iPriority++)
+    {
+      if (PrioListTest(pont_event->OSEventWaitList, iPriority))
+      {
+        ContextTask[PriorityVector[iPriority]].State = READY;
+      }
+    }
+    #endif
+
+    // Put all the waiting tasks into the Ready List at once
+    OSWaitListWakeAll(pont_event->OSEventWaitList);
+    pont_event->OSEventWait = 0;
+
+    // If outside of an interrupt service routine, change context to the highest priority task
+    // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+    if (!iNesting)
+    {
+      ChangeContext();
+    }
+  }
+
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,241 @@
+/**
+* \file defer.c
+* \brief BRTOS Deferred Call functions
+*
+* Functions to defer the interrupt processing to a kernel task
+*
+**/
+/*********************************************************************************************************
+*                                               BRTOS
+*                                Brazilian Real-Time Operating System
+*                            Acronymous of Basic Real-Time Operating System
+*
+*
+*                                  Open Source RTOS under MIT License
+*
+*
+*
+*                                    OS Deferred Call functions
+*
+*
+*   Revision: 1.80
+*   Date:     17/10/2026
+*
+*  An interrupt handler calls OSDeferCall() to run a function at task level.
+*  The function pointer and its argument are copied into a static ring buffer
+*  of BRTOS_DEFER_SIZE entries, so nothing is allocated. One kernel task,
+*  installed by OSDeferInit(), runs the calls in the order they were made.
+*  The drivers do not need a task and a stack only to handle the deferred
+*  work of their interrupts.
+*
+*********************************************************************************************************/
+
+#include "BRTOS.h"
+
+#if (PROCESSOR == COLDFIRE_V1)
+#pragma warn_implicitconv off
+#endif
+
+#if (BRTOS_DEFER_EN == 1)
+
+/* private data */
+static struct {
+    FCN_DEFERRED    func[BRTOS_DEFER_SIZE];   /* deferred functions */
+    void           *arg[BRTOS_DEFER_SIZE];    /* deferred function arguments */
+    INT8U           in;                       /* next free entry */
+    INT8U           out;                      /* next call to run */
+    INT8U           count;                    /* number of pending calls */
+    INT8U           task;                     /* deferred call task ID */
+    INT8U           waiting;                  /* the task waits for a call */
+} BRTOS_DEFER_VECTOR;
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Deferred Call Task                          /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#if (TASK_WITH_PARAMETERS == 1)
+static void BRTOS_DeferTask(void *parameters)
+#else
+static void BRTOS_DeferTask(void)
+#endif
+{
+  OS_SR_SAVE_VAR
+  FCN_DEFERRED func;
+  void        *arg;
+  ContextType *Task;
+
+  BRTOS_DEFER_VECTOR.task = currentTask;
+  Task = (ContextType*)&ContextTask[currentTask];
+
+  for (;;)
+  {
+    // Enter Critical Section
+    OSEnterCritical();
+
+    while (BRTOS_DEFER_VECTOR.count == 0)
+    {
+      BRTOS_DEFER_VECTOR.waiting = TRUE;
+
+      // Task entered suspended state, waiting for deferred calls
+      #if (VERBOSE == 1)
+      Task->State = SUSPENDED;
+      Task->SuspendedType = DEFERRED;
+      #endif
+
+      // Remove current task from the Ready List
+      OSReadyListRemove(currentTask, Task->Priority);
+
+      Task->TimeToWait = NO_TIMEOUT;
+
+      // Change Context - Returns when a call is deferred
+      ChangeContext();
+
+      // Exit Critical Section
+      OSExitCritical();
+      // Enter Critical Section
+      OSEnterCritical();
+    }
+
+    // Take the oldest call
+    func = BRTOS_DEFER_VECTOR.func[BRTOS_DEFER_VECTOR.out];
+    arg  = BRTOS_DEFER_VECTOR.arg[BRTOS_DEFER_VECTOR.out];
+
+    BRTOS_DEFER_VECTOR.out++;
+    if (BRTOS_DEFER_VECTOR.out == BRTOS_DEFER_SIZE)
+    {
+      BRTOS_DEFER_VECTOR.out = 0;
+    }
+    BRTOS_DEFER_VECTOR.count--;
+
+    // Exit Critical Section
+    OSExitCritical();
+
+    // The call runs with the interrupts enabled
+    func(arg);
+  }
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Deferred Call Init Function                 /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDeferInit(INT16U stacksize, INT8U prio)
+{
+  BRTOS_DEFER_VECTOR.in      = 0;
+  BRTOS_DEFER_VECTOR.out     = 0;
+  BRTOS_DEFER_VECTOR.count   = 0;
+  BRTOS_DEFER_VECTOR.task    = 0;
+  BRTOS_DEFER_VECTOR.waiting = FALSE;
+
+  #if (TASK_WITH_PARAMETERS == 1)
+  return InstallTask(&BRTOS_DeferTask, "BRTOS Deferred Task", stacksize, prio, NULL, NULL);
+  #else
+  return InstallTask(&BRTOS_DeferTask, "BRTOS Deferred Task", stacksize, prio, NULL);
+  #endif
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Deferred Call Function                      /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDeferCall(FCN_DEFERRED func, void *arg)
+{
+  OS_SR_SAVE_VAR
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the function pointer is NULL
+    if(func == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+
+  // The call is lost if the ring buffer is full
+  if (BRTOS_DEFER_VECTOR.count >= BRTOS_DEFER_SIZE)
+  {
+    // Exit Critical Section
+    #if (NESTING_INT == 0)
+    if (!iNesting)
+    #endif
+       OSExitCritical();
+    return BUFFER_UNDERRUN;
+  }
+
+  BRTOS_DEFER_VECTOR.func[BRTOS_DEFER_VECTOR.in] = func;
+  BRTOS_DEFER_VECTOR.arg[BRTOS_DEFER_VECTOR.in]  = arg;
+
+  BRTOS_DEFER_VECTOR.in++;
+  if (BRTOS_DEFER_VECTOR.in == BRTOS_DEFER_SIZE)
+  {
+    BRTOS_DEFER_VECTOR.in = 0;
+  }
+  BRTOS_DEFER_VECTOR.count++;
+
+  // Wake the deferred call task
+  if (BRTOS_DEFER_VECTOR.waiting == TRUE)
+  {
+    BRTOS_DEFER_VECTOR.waiting = FALSE;
+
+    #if (VERBOSE == 1)
+    ContextTask[BRTOS_DEFER_VECTOR.task].State = READY;
+    #endif
+
+    OSReadyListAdd(BRTOS_DEFER_VECTOR.task, ContextTask[BRTOS_DEFER_VECTOR.task].Priority);
+
+    // If outside of an interrupt service routine, change context to the highest priority task
+    // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+    if (!iNesting)
+    {
+      ChangeContext();
+    }
+  }
+
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#endif
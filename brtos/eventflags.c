@@ -0,0 +1,547 @@
+/**
+* \file eventflags.c
+* \brief BRTOS Event Flags functions
+*
+* Functions to install and use event flag groups
+*
+**/
+/*********************************************************************************************************
+*                                               BRTOS
+*                                Brazilian Real-Time Operating System
+*                            Acronymous of Basic Real-Time Operating System
+*
+*
+*                                  Open Source RTOS under MIT License
+*
+*
+*
+*                                      OS Event Flags functions
+*
+*
+*   Revision: 1.80
+*   Date:     17/10/2026
+*
+*********************************************************************************************************/
+
+#include "BRTOS.h"
+
+#if (PROCESSOR == COLDFIRE_V1)
+#pragma warn_implicitconv off
+#endif
+
+#if (BRTOS_FLAG_EN == 1)
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Event Flags Internal Function               /////
+/////                                                  /////
+/////  Must be called inside a critical section        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Verifies the wait condition of a task
+// Returns the flags that satisfy the condition, or zero
+static FlagType OSFlagTest(FlagType flags, FlagType mask, INT8U options)
+{
+  FlagType ready = flags & mask;
+
+  if (options & FLAG_WAIT_ALL)
+  {
+    if (ready != mask)
+    {
+      ready = 0;
+    }
+  }
+
+  return ready;
+}
+
+// Releases a waiting task if the flags satisfy its wait condition
+// Returns TRUE if the task was released
+static INT8U OSFlagRelease(BRTOS_Flag *pont_event, INT8U TaskSelect, INT8U iPriority)
+{
+  ContextType *Task = (ContextType*)&ContextTask[TaskSelect];
+  FlagType ready;
+
+  ready = OSFlagTest(pont_event->OSEventFlags, Task->FlagWait, Task->FlagOptions);
+
+  if (!ready)
+  {
+    return FALSE;
+  }
+
+  if (Task->FlagOptions & FLAG_CLEAR_ON_EXIT)
+  {
+    pont_event->OSEventFlags &= (FlagType)~ready;
+  }
+
+  // Gives the flags that released the task
+  Task->FlagWait = ready;
+
+  // Remove the selected task from the event flags wait list
+  OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
+
+  // Decreases the event flags wait list counter
+  pont_event->OSEventWait--;
+
+  // Put the selected task into Ready List
+  #if (VERBOSE == 1)
+  Task->State = READY;
+  #endif
+
+  OSReadyListAdd(TaskSelect, iPriority);
+
+  return TRUE;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Create Event Flags Function                 /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSFlagCreate (FlagType flags, BRTOS_Flag **event)
+{
+  OS_SR_SAVE_VAR
+  int i=0;
+
+  BRTOS_Flag *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be create by interrupt
+  }
+
+  // Enter critical Section
+  if (currentTask)
+     OSEnterCritical();
+
+  // Verifies if there is available event control block
+  for(i=0;i<=BRTOS_MAX_FLAG;i++)
+  {
+
+    if(i >= BRTOS_MAX_FLAG)
+    {
+      // Exit critical Section
+      if (currentTask)
+         OSExitCritical();
+
+      return(NO_AVAILABLE_EVENT);
+    }
+
+    if(BRTOS_Flag_Table[i].OSEventAllocated != TRUE)
+    {
+      BRTOS_Flag_Table[i].OSEventAllocated = TRUE;
+      pont_event = &BRTOS_Flag_Table[i];
+      break;
+    }
+  }
+
+  pont_event->OSEventFlags = flags;                    // Set the initial flags
+  pont_event->OSEventWait  = 0;
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = pont_event;
+
+  // Exit critical Section
+  if (currentTask)
+     OSExitCritical();
+
+  return(ALLOC_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Delete Event Flags Function                 /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSFlagDelete (BRTOS_Flag **event)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_Flag *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be delete by interrupt
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  pont_event = *event;
+  pont_event->OSEventAllocated = 0;
+  pont_event->OSEventFlags     = 0;
+  pont_event->OSEventWait      = 0;
+
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = NULL;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return(DELETE_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Event Flags Pend Function                   /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSFlagPend (BRTOS_Flag *pont_event, FlagType mask, INT8U options, FlagType *flags, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U  iPriority = 0;
+  FlagType ready;
+  ContextType *Task;
+
+  #if (ERROR_CHECK == 1)
+    // Can not use event flags pend function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+
+    // Verifies if there is at least one flag to wait for
+    if(mask == 0)
+    {
+      return(INVALID_PARAMETERS);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // Verify if the condition is already satisfied
+  ready = OSFlagTest(pont_event->OSEventFlags, mask, options);
+  if (ready)
+  {
+    if (options & FLAG_CLEAR_ON_EXIT)
+    {
+      pont_event->OSEventFlags &= (FlagType)~ready;
+    }
+
+    if (flags != NULL)
+    {
+      *flags = ready;
+    }
+
+    // Exit Critical Section
+    OSExitCritical();
+    return OK;
+  }
+
+  Task = (ContextType*)&ContextTask[currentTask];
+
+  // Copy task priority to local scope
+  iPriority = Task->Priority;
+
+  // Keeps the wait condition in the task control block
+  Task->FlagWait    = mask;
+  Task->FlagOptions = options;
+
+  // Increases the event flags wait list counter
+  pont_event->OSEventWait++;
+
+  // Allocates the current task on the event flags wait list
+  OSWaitListAdd(pont_event->OSEventWaitList, currentTask, iPriority);
+
+  // Task entered suspended state, waiting for the flags
+  #if (VERBOSE == 1)
+  Task->State = SUSPENDED;
+  Task->SuspendedType = EVENT_FLAG;
+  #endif
+
+  // Remove current task from the Ready List
+  OSReadyListRemove(currentTask, iPriority);
+
+  // Set timeout overflow
+  if (time_wait)
+  {
+    Task->TimeToWait = OSWakeTimeCompute(time_wait);
+
+    // Put task into delay list
+    IncludeTaskIntoDelayList();
+  } else
+  {
+    Task->TimeToWait = NO_TIMEOUT;
+  }
+
+  // Change Context - Returns on time overflow or flags set
+  ChangeContext();
+
+  if (time_wait)
+  {
+      // Exit Critical Section
+      OSExitCritical();
+      // Enter Critical Section
+      OSEnterCritical();
+
+      // Verify if the reason of task wake up was timeout
+      if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+      {
+          // Test if both timeout and set have occured before arrive here
+          if (OSWaitListTest(pont_event->OSEventWaitList, currentTask, iPriority))
+          {
+            // Remove the task from the event flags wait list
+            OSWaitListRemove(pont_event->OSEventWaitList, currentTask, iPriority);
+
+            // Decreases the event flags wait list counter
+            pont_event->OSEventWait--;
+
+            if (flags != NULL)
+            {
+              *flags = pont_event->OSEventFlags & mask;
+            }
+
+            // Exit Critical Section
+            OSExitCritical();
+
+            // Indicates event flags timeout
+            return TIMEOUT;
+          }
+      }
+      else
+      {
+          // Remove the time to wait condition
+          Task->TimeToWait = NO_TIMEOUT;
+
+          // Remove from delay list
+          RemoveFromDelayList();
+      }
+  }
+
+  // The set function stores the flags that released the task
+  if (flags != NULL)
+  {
+    *flags = Task->FlagWait;
+  }
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Event Flags Set Function                    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSFlagSet (BRTOS_Flag *pont_event, FlagType flags)
+{
+  OS_SR_SAVE_VAR
+  INT8U iPriority = (INT8U)0;
+  INT8U Wakeup = FALSE;
+  #if (ROUND_ROBIN_EN == 1)
+  INT8U TaskSelect;
+  INT8U TaskNext;
+  #else
+  INT8U Waiting;
+  PriorityType WaitList;
+  #endif
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  pont_event->OSEventFlags |= flags;
+
+  // Verifies the waiting tasks, from the highest to the lowest priority
+  // A clear on exit of a task is seen by the lower priority tasks
+  #if (ROUND_ROBIN_EN == 1)
+  // The tasks that share a priority are verified in arrival order
+  TaskNext = OSWaitNext(&pont_event->OSEventWaitList, 0);
+  while (TaskNext != 0)
+  {
+    TaskSelect = TaskNext;
+    TaskNext = OSWaitNext(&pont_event->OSEventWaitList, TaskSelect);
+
+    iPriority = ContextTask[TaskSelect].Priority;
+    if (OSFlagRelease(pont_event, TaskSelect, iPriority) == TRUE)
+    {
+      Wakeup = TRUE;
+    }
+  }
+  #else
+  WaitList = pont_event->OSEventWaitList;
+  Waiting  = pont_event->OSEventWait;
+  while (Waiting != 0)
+  {
+    Waiting--;
+
+    iPriority = PrioListHighest(WaitList);
+    PrioListRemove(WaitList, iPriority);
+
+    if (OSFlagRelease(pont_event, PriorityVector[iPriority], iPriority) == TRUE)
+    {
+      Wakeup = TRUE;
+    }
+  }
+  #endif
+
+  // If outside of an interrupt service routine, change context to the highest priority task
+  // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+  if ((Wakeup == TRUE) && (!iNesting))
+  {
+    // Verify if there is a higher priority task ready to run
+    ChangeContext();
+  }
+
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Event Flags Clear Function                  /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSFlagClear (BRTOS_Flag *pont_event, FlagType flags)
+{
+  OS_SR_SAVE_VAR
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // Clearing flags never releases a task
+  pont_event->OSEventFlags &= (FlagType)~flags;
+
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,627 @@
+/**
+* \file eventset.c
+* \brief BRTOS Event Set functions
+*
+* Functions to wait on several semaphores, mailboxes and queues at once
+*
+**/
+/*********************************************************************************************************
+*                                               BRTOS
+*                                Brazilian Real-Time Operating System
+*                            Acronymous of Basic Real-Time Operating System
+*
+*
+*                                  Open Source RTOS under MIT License
+*
+*
+*
+*                                       OS Event Set functions
+*
+*
+*   Revision: 1.80
+*   Date:     17/10/2026
+*
+*  A set only signals which member is ready. The data is still taken with the
+*  member pend function, that returns at once if no other task took it first.
+*
+*********************************************************************************************************/
+
+#include "BRTOS.h"
+
+#if (PROCESSOR == COLDFIRE_V1)
+#pragma warn_implicitconv off
+#endif
+
+#if (BRTOS_SET_EN == 1)
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Event Set Internal Functions                /////
+/////                                                  /////
+/////  Must be called inside a critical section        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Returns the address of the set pointer of a member, or NULL for an invalid type
+static BRTOS_Set **OSSetField(void *member, INT8U type)
+{
+  switch(type)
+  {
+    #if (BRTOS_SEM_EN == 1)
+    case SET_SEM:
+      return &((BRTOS_Sem*)member)->OSEventSet;
+    #endif
+
+    #if (BRTOS_MBOX_EN == 1)
+    case SET_MBOX:
+      return &((BRTOS_Mbox*)member)->OSEventSet;
+    #endif
+
+    #if (BRTOS_QUEUE_EN == 1)
+    case SET_QUEUE:
+    #if (BRTOS_DYNAMIC_QUEUE_ENABLED == 1)
+    case SET_DQUEUE:
+    #endif
+      return &((BRTOS_Queue*)member)->OSEventSet;
+    #endif
+
+    default:
+      return NULL;
+  }
+}
+
+
+// Verifies if a member has data to be taken
+static INT8U OSSetMemberReady(void *member, INT8U type)
+{
+  switch(type)
+  {
+    #if (BRTOS_SEM_EN == 1)
+    case SET_SEM:
+      return (INT8U)(((BRTOS_Sem*)member)->OSEventCount > 0);
+    #endif
+
+    #if (BRTOS_MBOX_EN == 1)
+    case SET_MBOX:
+      return (INT8U)(((BRTOS_Mbox*)member)->OSEventState == AVAILABLE_MESSAGE);
+    #endif
+
+    #if (BRTOS_QUEUE_EN == 1)
+    case SET_QUEUE:
+      return (INT8U)(((OS_QUEUE*)((BRTOS_Queue*)member)->OSEventPointer)->OSQEntries > 0);
+    #endif
+
+    #if (BRTOS_QUEUE_EN == 1) && (BRTOS_DYNAMIC_QUEUE_ENABLED == 1)
+    case SET_DQUEUE:
+      return (INT8U)(((OS_DQUEUE*)((BRTOS_Queue*)member)->OSEventPointer)->OSQEntries > 0);
+    #endif
+
+    default:
+      return FALSE;
+  }
+}
+
+
+// Returns the first ready member, or NULL
+// The search starts after the last returned member, so a busy member does not hide the others
+static void *OSSetScan(BRTOS_Set *pont_event)
+{
+  INT8U i;
+  INT8U j = pont_event->OSSetNext;
+
+  for (i = 0; i < pont_event->OSSetCount; i++)
+  {
+    if (j >= pont_event->OSSetCount)
+    {
+      j = 0;
+    }
+
+    if (OSSetMemberReady(pont_event->OSSetMember[j], pont_event->OSSetType[j]))
+    {
+      pont_event->OSSetNext = (INT8U)(j + 1);
+      return pont_event->OSSetMember[j];
+    }
+
+    j++;
+  }
+
+  return NULL;
+}
+
+
+// Removes a member from its set
+// Returns FALSE if the member does not belong to the set
+INT8U OSSetUnlink(BRTOS_Set *pont_event, void *member)
+{
+  INT8U i;
+
+  for (i = 0; i < pont_event->OSSetCount; i++)
+  {
+    if (pont_event->OSSetMember[i] == member)
+    {
+      *OSSetField(member, pont_event->OSSetType[i]) = NULL;
+
+      // Keeps the member list packed
+      pont_event->OSSetCount--;
+      pont_event->OSSetMember[i] = pont_event->OSSetMember[pont_event->OSSetCount];
+      pont_event->OSSetType[i]   = pont_event->OSSetType[pont_event->OSSetCount];
+
+      if (pont_event->OSSetSignaled == member)
+      {
+        pont_event->OSSetSignaled = NULL;
+      }
+
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+
+// Called by the member post functions when no task was waiting for the member
+// Returns TRUE if a task waiting for the set was released
+INT8U OSSetSignal(BRTOS_Set *pont_event, void *member)
+{
+  INT8U iPriority;
+  INT8U TaskSelect = 0;
+
+  if (pont_event == NULL)
+  {
+    return FALSE;
+  }
+
+  pont_event->OSSetSignaled = member;
+
+  if (pont_event->OSEventWait == 0)
+  {
+    return FALSE;
+  }
+
+  // Selects the highest priority task
+  iPriority = PrioListHighest(pont_event->OSEventWaitList);
+  TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
+
+  // Remove the selected task from the set wait list
+  OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
+
+  // Decreases the set wait list counter
+  pont_event->OSEventWait--;
+
+  // Put the selected task into Ready List
+  #if (VERBOSE == 1)
+  ContextTask[TaskSelect].State = READY;
+  #endif
+
+  OSReadyListAdd(TaskSelect, iPriority);
+
+  return TRUE;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Create Event Set Function                   /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSSetCreate (BRTOS_Set **event)
+{
+  OS_SR_SAVE_VAR
+  int i=0;
+
+  BRTOS_Set *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be create by interrupt
+  }
+
+  // Enter critical Section
+  if (currentTask)
+     OSEnterCritical();
+
+  // Verifies if there is available event control block
+  for(i=0;i<=BRTOS_MAX_SET;i++)
+  {
+
+    if(i >= BRTOS_MAX_SET)
+    {
+      // Exit critical Section
+      if (currentTask)
+         OSExitCritical();
+
+      return(NO_AVAILABLE_EVENT);
+    }
+
+    if(BRTOS_Set_Table[i].OSEventAllocated != TRUE)
+    {
+      BRTOS_Set_Table[i].OSEventAllocated = TRUE;
+      pont_event = &BRTOS_Set_Table[i];
+      break;
+    }
+  }
+
+  pont_event->OSSetCount    = 0;
+  pont_event->OSSetNext     = 0;
+  pont_event->OSSetSignaled = NULL;
+  pont_event->OSEventWait   = 0;
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = pont_event;
+
+  // Exit critical Section
+  if (currentTask)
+     OSExitCritical();
+
+  return(ALLOC_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Delete Event Set Function                   /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSSetDelete (BRTOS_Set **event)
+{
+  OS_SR_SAVE_VAR
+  INT8U i;
+  BRTOS_Set *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be delete by interrupt
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  pont_event = *event;
+
+  // The members leave the set
+  for (i = 0; i < pont_event->OSSetCount; i++)
+  {
+    *OSSetField(pont_event->OSSetMember[i], pont_event->OSSetType[i]) = NULL;
+  }
+
+  pont_event->OSEventAllocated = 0;
+  pont_event->OSSetCount       = 0;
+  pont_event->OSSetSignaled    = NULL;
+  pont_event->OSEventWait      = 0;
+
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = NULL;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return(DELETE_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Event Set Add Member Function               /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSSetAdd (BRTOS_Set *pont_event, void *member, INT8U type)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_Set **set;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be changed by interrupt
+  }
+
+  if ((pont_event == NULL) || (member == NULL))
+  {
+    return(NULL_EVENT_POINTER);
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  set = OSSetField(member, type);
+
+  // A member belongs to only one set
+  if ((set == NULL) || (*set != NULL))
+  {
+    // Exit Critical Section
+    OSExitCritical();
+    return(INVALID_PARAMETERS);
+  }
+
+  if (pont_event->OSSetCount >= BRTOS_SET_MEMBERS)
+  {
+    // Exit Critical Section
+    OSExitCritical();
+    return(NO_AVAILABLE_MEMORY);
+  }
+
+  pont_event->OSSetMember[pont_event->OSSetCount] = member;
+  pont_event->OSSetType[pont_event->OSSetCount]   = type;
+  pont_event->OSSetCount++;
+  *set = pont_event;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Event Set Remove Member Function            /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSSetRemove (BRTOS_Set *pont_event, void *member)
+{
+  OS_SR_SAVE_VAR
+  INT8U removed;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be changed by interrupt
+  }
+
+  if ((pont_event == NULL) || (member == NULL))
+  {
+    return(NULL_EVENT_POINTER);
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  removed = OSSetUnlink(pont_event, member);
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  if (removed == FALSE)
+  {
+    return(INVALID_PARAMETERS);
+  }
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Event Set Pend Function                     /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSSetPend (BRTOS_Set *pont_event, void **member, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U  iPriority = 0;
+  INT8U  expired = FALSE;
+  void   *ready;
+  TickType wake_time = NO_TIMEOUT;
+  TickType start = 0;
+  TickType now;
+  TickType elapsed;
+  ContextType *Task;
+
+  #if (ERROR_CHECK == 1)
+    // Can not use event set pend function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+
+    // Verifies if the pointer is NULL
+    if((pont_event == NULL) || (member == NULL))
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // Verify if a member is already ready
+  ready = OSSetScan(pont_event);
+  if (ready != NULL)
+  {
+    *member = ready;
+
+    // Exit Critical Section
+    OSExitCritical();
+    return OK;
+  }
+
+  Task = (ContextType*)&ContextTask[currentTask];
+
+  if (time_wait)
+  {
+    start = OSGetCount();
+    wake_time = OSWakeTimeCompute(time_wait);
+  }
+
+  // Waits again if the signaled member is removed from the set before this task runs
+  do
+  {
+    // Copy task priority to local scope
+    iPriority = Task->Priority;
+
+    // Increases the set wait list counter
+    pont_event->OSEventWait++;
+
+    // Allocates the current task on the set wait list
+    OSWaitListAdd(pont_event->OSEventWaitList, currentTask, iPriority);
+
+    // Task entered suspended state, waiting for a member
+    #if (VERBOSE == 1)
+    Task->State = SUSPENDED;
+    Task->SuspendedType = EVENT_SET;
+    #endif
+
+    // Remove current task from the Ready List
+    OSReadyListRemove(currentTask, iPriority);
+
+    // Set timeout overflow
+    Task->TimeToWait = wake_time;
+
+    if (time_wait)
+    {
+      // Put task into delay list
+      IncludeTaskIntoDelayList();
+    }
+
+    // Change Context - Returns on time overflow or member post
+    ChangeContext();
+
+    // Exit Critical Section
+    OSExitCritical();
+    // Enter Critical Section
+    OSEnterCritical();
+
+    if (time_wait)
+    {
+        // Verify if the reason of task wake up was timeout
+        if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+        {
+            // Test if both timeout and post have occured before arrive here
+            if (OSWaitListTest(pont_event->OSEventWaitList, currentTask, iPriority))
+            {
+              // Remove the task from the set wait list
+              OSWaitListRemove(pont_event->OSEventWaitList, currentTask, iPriority);
+
+              // Decreases the set wait list counter
+              pont_event->OSEventWait--;
+
+              *member = NULL;
+
+              // Exit Critical Section
+              OSExitCritical();
+
+              // Indicates event set timeout
+              return TIMEOUT;
+            }
+
+            // Released by a post at the wake time
+            expired = TRUE;
+        }
+        else
+        {
+            // Remove the time to wait condition
+            Task->TimeToWait = NO_TIMEOUT;
+
+            // Remove from delay list
+            RemoveFromDelayList();
+
+            // A task that runs late may find its wake time already passed
+            now = OSGetCount();
+            if (now >= start)
+            {
+              elapsed = (TickType)(now - start);
+            }
+            else
+            {
+              elapsed = (TickType)(TICK_COUNT_OVERFLOW - start + now);
+            }
+
+            if (elapsed >= time_wait)
+            {
+              expired = TRUE;
+            }
+        }
+    }
+
+    // A higher priority task may have taken the data before this task runs
+    // In this case the signaled member is returned, and its pend waits for new data
+    ready = OSSetScan(pont_event);
+    if (ready == NULL)
+    {
+      ready = pont_event->OSSetSignaled;
+    }
+
+    if ((ready == NULL) && (expired == TRUE))
+    {
+      *member = NULL;
+
+      // Exit Critical Section
+      OSExitCritical();
+
+      // Indicates event set timeout
+      return TIMEOUT;
+    }
+  } while (ready == NULL);
+
+  *member = ready;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#endif
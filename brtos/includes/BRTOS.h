@@ -54,7 +54,7 @@
 
 
 // Brtos version
-#define BRTOS_VERSION   "BRTOS Ver. 1.79"
+#define BRTOS_VERSION   "BRTOS Ver. 1.80"
 
 /// False and True defines
 #ifndef FALSE
@@ -73,6 +73,17 @@
 #define READY_LIST_VAR
 #endif
 
+/// Highest priority lookup methods (OPTIMIZED_SCHEDULER in HAL.h)
+#define SCHED_SA_TREE                 0     ///< Sucessive aproximation (if-tree)
+#define SCHED_HAL                     1     ///< Optimezed_Scheduler() of the port (CLZ / FF1 instruction)
+#define SCHED_BUILTIN_CLZ             2     ///< Compiler __builtin_clzl (GCC / Clang)
+#define SCHED_LOOKUP_TABLE            3     ///< 256 bytes table, one lookup per byte (8/16 bits cores)
+#define SCHED_DE_BRUIJN               4     ///< De Bruijn multiplication (32 bits cores without CLZ)
+
+#ifndef OPTIMIZED_SCHEDULER
+#define OPTIMIZED_SCHEDULER           SCHED_SA_TREE
+#endif
+
 #define BRTOS_BIG_ENDIAN              (0)
 #define BRTOS_LITTLE_ENDIAN           (1)
 
@@ -80,6 +91,185 @@
 #define BRTOS_TH                      OS_CPU_TYPE
 #endif
 
+/// Round-robin defaults
+#ifndef ROUND_ROBIN_EN
+#define ROUND_ROBIN_EN                0
+#endif
+
+#ifndef TIME_SLICE_TICKS
+#define TIME_SLICE_TICKS              (INT16U)10   ///< Time slice, in ticks, of the tasks that share a priority
+#endif
+
+/// Task delete defaults
+#ifndef TASK_DELETE_EN
+#define TASK_DELETE_EN                0
+#endif
+
+/// Scheduler lock defaults
+#ifndef BRTOS_SCHED_LOCK_EN
+#define BRTOS_SCHED_LOCK_EN           0
+#endif
+
+/// Stack watermark defaults
+#ifndef STACK_WATERMARK_EN
+#define STACK_WATERMARK_EN            0
+#endif
+
+#ifndef STACK_PAINT_PATTERN
+#define STACK_PAINT_PATTERN           (OS_CPU_TYPE)0xA5A5A5A5UL  ///< Value written into the free stack at task install
+#endif
+
+#ifndef STACK_WATERMARK_STEP
+#define STACK_WATERMARK_STEP          (INT16U)8    ///< Stack words verified by each idle task loop
+#endif
+
+/// Memory pool defaults
+#ifndef BRTOS_MEMPOOL_EN
+#define BRTOS_MEMPOOL_EN              0
+#endif
+
+#ifndef BRTOS_MAX_MEMPOOL
+#define BRTOS_MAX_MEMPOOL             4
+#endif
+
+#ifndef BRTOS_DQUEUE_MEMPOOL_EN
+#define BRTOS_DQUEUE_MEMPOOL_EN       0            ///< Dynamic queues allocate from the memory pools
+#endif
+
+/// Task notification defaults
+#ifndef TASK_NOTIFY_EN
+#define TASK_NOTIFY_EN                0
+#endif
+
+/// Event flags defaults
+#ifndef BRTOS_FLAG_EN
+#define BRTOS_FLAG_EN                 0
+#endif
+
+#ifndef BRTOS_MAX_FLAG
+#define BRTOS_MAX_FLAG                4
+#endif
+
+#ifndef BRTOS_FLAG_32BITS
+#define BRTOS_FLAG_32BITS             0            ///< 32 flags per group instead of 16
+#endif
+
+/// Stream buffer defaults
+#ifndef BRTOS_STREAM_EN
+#define BRTOS_STREAM_EN               0
+#endif
+
+#ifndef BRTOS_MAX_STREAM
+#define BRTOS_MAX_STREAM              2
+#endif
+
+/// Blocking queue and mailbox post defaults
+#ifndef BRTOS_POST_WAIT_EN
+#define BRTOS_POST_WAIT_EN            0
+#endif
+
+/// Dynamic queue zero-copy slots defaults
+#ifndef BRTOS_DQUEUE_SLOT_EN
+#define BRTOS_DQUEUE_SLOT_EN          0
+#endif
+
+/// Priority inheritance mutex defaults
+#ifndef BRTOS_MUTEX_INHERIT_EN
+#define BRTOS_MUTEX_INHERIT_EN        0
+#endif
+
+/// Recursive mutex defaults
+#ifndef BRTOS_MUTEX_RECURSIVE_EN
+#define BRTOS_MUTEX_RECURSIVE_EN      0
+#endif
+
+/// Reader-writer lock defaults
+#ifndef BRTOS_RWLOCK_EN
+#define BRTOS_RWLOCK_EN               0
+#endif
+
+#ifndef BRTOS_MAX_RWLOCK
+#define BRTOS_MAX_RWLOCK              2
+#endif
+
+/// Condition variable defaults
+#ifndef BRTOS_COND_EN
+#define BRTOS_COND_EN                 0
+#endif
+
+#ifndef BRTOS_MAX_COND
+#define BRTOS_MAX_COND                2
+#endif
+
+/// Barrier defaults
+#ifndef BRTOS_BARRIER_EN
+#define BRTOS_BARRIER_EN              0
+#endif
+
+#ifndef BRTOS_MAX_BARRIER
+#define BRTOS_MAX_BARRIER             2
+#endif
+
+/// Deferred call defaults
+#ifndef BRTOS_DEFER_EN
+#define BRTOS_DEFER_EN                0
+#endif
+
+#ifndef BRTOS_DEFER_SIZE
+#define BRTOS_DEFER_SIZE              8
+#endif
+
+/// Work queue defaults
+#ifndef BRTOS_WORK_EN
+#define BRTOS_WORK_EN                 0
+#endif
+
+#ifndef BRTOS_WORK_QUEUE_SIZE
+#define BRTOS_WORK_QUEUE_SIZE         8
+#endif
+
+/// Shared object pool defaults
+#ifndef BRTOS_OBJECT_POOL_EN
+#define BRTOS_OBJECT_POOL_EN          0
+#endif
+
+#ifndef BRTOS_MAX_OBJECTS
+#define BRTOS_MAX_OBJECTS             16
+#endif
+
+/// Event set defaults
+#ifndef BRTOS_SET_EN
+#define BRTOS_SET_EN                  0
+#endif
+
+#ifndef BRTOS_MAX_SET
+#define BRTOS_MAX_SET                 2
+#endif
+
+#ifndef BRTOS_SET_MEMBERS
+#define BRTOS_SET_MEMBERS             4            ///< Maximum number of objects in a set
+#endif
+
+/// Tickless idle defaults - the port must provide the TickTimerSleep() hook
+#ifndef TICKLESS_IDLE_EN
+#define TICKLESS_IDLE_EN              0
+#endif
+
+#ifndef TICKLESS_IDLE_MIN_TICKS
+#define TICKLESS_IDLE_MIN_TICKS       (INT16U)2    ///< Minimum idle period, in ticks, to stop the tick timer
+#endif
+
+#if (TICKLESS_IDLE_EN == 1) && !defined(TICK_TIMER_SLEEP)
+  #error("TICKLESS_IDLE_EN requires a port with the TickTimerSleep() hook, as GCC_CORTEX-M4 !!!")
+#endif
+
+/// A task released with a kept slot records it, so OSTaskDelete can give the slot back
+#if ((TASK_DELETE_EN == 1) && ((BRTOS_POST_WAIT_EN == 1) || (BRTOS_MEMPOOL_EN == 1)))
+#define TASK_RESERVATION_EN           1
+#else
+#define TASK_RESERVATION_EN           0
+#endif
+
 
 /// Task States
 #define READY                        (INT8U)0     ///< Task is ready to be executed - waiting for the scheduler authorization
@@ -87,13 +277,33 @@
 #define BLOCKED                      (INT8U)2     ///< Task is blocked - Will not run until be released
 #define MUTEX_PRIO                   (INT8U)0xFE
 #define EMPTY_PRIO                   (INT8U)0xFF
+#define MUTEX_INHERIT                (INT8U)0xFF  ///< OSMutexCreate priority of a priority inheritance mutex
+
+#if (ROUND_ROBIN_EN == 1)
+/// Round-robin ready states
+#define RR_READY                     (INT8U)0x01  ///< Task is not waiting for a delay or an event
+#define RR_BLOCKED                   (INT8U)0x02  ///< Task is blocked by BlockTask or BlockPriority
+#define RR_QUEUED                    (INT8U)0x04  ///< Task is in the ready FIFO of its priority
+#endif
 
 
 /// Timer defines
-#define NO_TIMEOUT                  (INT16U)65000
-#define EXIT_BY_TIMEOUT             (INT16U)65001
-#define TICK_COUNT_OVERFLOW         (INT16U)64000       ///< Determines the tick timer overflow
-#define TickCountOverFlow           (INT16U)64000       ///< Compatibility with BRTOS less than or equal to 1.7
+#ifndef TICK_COUNT_32BITS
+#define TICK_COUNT_32BITS           0
+#endif
+
+#if (TICK_COUNT_32BITS == 1)
+  typedef INT32U TickType;                                   ///< Tick counter, delays and timeouts
+  #define NO_TIMEOUT                (TickType)0xFFFFFFFFUL
+  #define EXIT_BY_TIMEOUT           (TickType)0xFFFFFFFEUL
+  #define TICK_COUNT_OVERFLOW       (TickType)0xFFFFFFFEUL   ///< Determines the tick timer overflow
+#else
+  typedef INT16U TickType;                                   ///< Tick counter, delays and timeouts
+  #define NO_TIMEOUT                (TickType)65000
+  #define EXIT_BY_TIMEOUT           (TickType)65001
+  #define TICK_COUNT_OVERFLOW       (TickType)64000          ///< Determines the tick timer overflow
+#endif
+#define TickCountOverFlow           TICK_COUNT_OVERFLOW      ///< Compatibility with BRTOS less than or equal to 1.7
 
 /// Error codes
 #define OK                           (INT8U)0     ///< OK define
@@ -107,6 +317,10 @@
 #define NOT_VALID_TASK               (INT8U)8     ///< There current task number is not valid for this function
 #define NO_TASK_DELAY                (INT8U)9     ///< Error - No valid time to wait
 #define END_OF_AVAILABLE_TCB         (INT8U)10    ///< Error - There are no more task control blocks (Context task)
+#define TASK_OWNS_MUTEX              (INT8U)11    ///< Error - The task owns a mutex and can not be deleted
+#define SCHED_LOCK_OVF               (INT8U)12    ///< Error - Scheduler lock nesting overflow
+#define SCHED_NOT_LOCKED             (INT8U)13    ///< Error - The scheduler is not locked
+#define SCHED_LOCK_PEND_ERR          (INT8U)15    ///< Error - Function can not wait while the scheduler is locked
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -165,11 +379,66 @@
 #define MAILBOX   2                               ///< Task suspended by mailbox
 #define QUEUE     3                               ///< Task suspended by queue
 #define MUTEX     4                               ///< Task suspended by mutex
+#define MEMPOOL   5                               ///< Task suspended by memory pool
+#define EVENT_FLAG 6                              ///< Task suspended by event flags
+#define NOTIFICATION 7                            ///< Task suspended by task notification
+#define STREAM    8                               ///< Task suspended by stream buffer
+#define EVENT_SET 9                               ///< Task suspended by event set
+#define RWLOCK    10                              ///< Task suspended by reader-writer lock
+#define CONDITION 11                              ///< Task suspended by condition variable
+#define BARRIER   12                              ///< Task suspended by barrier
+#define DEFERRED  13                              ///< Deferred call task waiting for calls
+
+
+
+/// Event flags type and pend options
+#if (BRTOS_FLAG_32BITS == 1)
+  typedef INT32U FlagType;                                   ///< Flags of an event flag group
+#else
+  typedef INT16U FlagType;                                   ///< Flags of an event flag group
+#endif
+
+#define FLAG_WAIT_ANY                (INT8U)0     ///< The pend returns when any flag of the mask is set
+#define FLAG_WAIT_ALL                (INT8U)1     ///< The pend returns when all the flags of the mask are set
+#define FLAG_CLEAR_ON_EXIT           (INT8U)2     ///< The flags that released the pend are cleared
+
+
+/// Task notification actions and states
+#define NOTIFY_SET_BITS              (INT8U)0     ///< The value bits are set in the notification word
+#define NOTIFY_INCREMENT             (INT8U)1     ///< The notification word is incremented (value is ignored)
+#define NOTIFY_OVERWRITE             (INT8U)2     ///< The notification word receives the value
+
+#define NOTIFY_NONE                  (INT8U)0     ///< There is no notification
+#define NOTIFY_PENDING               (INT8U)1     ///< There is a notification not yet taken
+#define NOTIFY_WAITING               (INT8U)2     ///< The task is waiting for a notification
+
+
+/// Event set member types
+#define SET_SEM                      (INT8U)0     ///< Semaphore member
+#define SET_MBOX                     (INT8U)1     ///< Mailbox member
+#define SET_QUEUE                    (INT8U)2     ///< Queue member
+#define SET_DQUEUE                   (INT8U)3     ///< Dynamic queue member
 
 
 
 /// Task Defines
 
+#if (NUMBER_OF_PRIORITIES > 32)
+  // Two-level bitmap: one bit per group of 32 priorities plus one word per group
+  #if ((NUMBER_OF_PRIORITIES > 256) || ((NUMBER_OF_PRIORITIES % 32) != 0))
+    #error("NUMBER_OF_PRIORITIES above 32 must be a multiple of 32, up to 256 !!!")
+  #endif
+  #define configMAX_TASK_INSTALL  NUMBER_OF_PRIORITIES ///< Defines the maximum number of tasks that can be installed
+  #define configMAX_TASK_PRIORITY (NUMBER_OF_PRIORITIES - 1)
+  #define PRIORITY_GROUPS         (NUMBER_OF_PRIORITIES / 32)
+  #define PRIORITY_BITS           32
+  typedef INT32U PriorityBits;
+  typedef struct
+  {
+    INT8U        Group;                    ///< Groups with at least one priority in the list
+    PriorityBits Bits[PRIORITY_GROUPS];    ///< Priorities of each group
+  } PriorityType;
+#else
 #if (NUMBER_OF_PRIORITIES > 16)
   #define configMAX_TASK_INSTALL  32                 ///< Defines the maximum number of tasks that can be installed
   #define configMAX_TASK_PRIORITY 31  
@@ -185,6 +454,65 @@
     typedef INT8U PriorityType;
   #endif
 #endif
+  #define PRIORITY_BITS           (configMAX_TASK_PRIORITY + 1)
+  typedef PriorityType PriorityBits;
+#endif
+
+/// Words of the task control block allocation bitmap
+#define TASK_ALLOC_WORDS        ((NUMBER_OF_TASKS + 31) / 32)
+
+
+/// Priority lists (ready list, blocked list and event wait lists) manipulation
+#if (NUMBER_OF_PRIORITIES > 32)
+  #define PRIORITY_GROUP(prio)          ((INT8U)(prio) >> 5)
+  #define PRIORITY_BIT(prio)            ((INT8U)(prio) & 0x1F)
+  #define PrioListInit(list)            OSPrioListInit(&(list))
+  #define PrioListAdd(list, prio)       OSPrioListAdd(&(list), (prio))
+  #define PrioListRemove(list, prio)    OSPrioListRemove(&(list), (prio))
+  #define PrioListTest(list, prio)      ((list).Bits[PRIORITY_GROUP(prio)] & PriorityMask[PRIORITY_BIT(prio)])
+  #define PrioListHighest(list)         OSPrioListHighest(&(list))
+  #define PrioListHighestReady()        OSPrioListHighestReady()
+  #define PrioListMerge(list, src)      OSPrioListMerge(&(list), &(src))
+#else
+  #define PrioListInit(list)            (list) = 0
+  #define PrioListAdd(list, prio)       (list) = (list) | (PriorityMask[prio])
+  #define PrioListRemove(list, prio)    (list) = (list) & ~(PriorityMask[prio])
+  #define PrioListTest(list, prio)      ((list) & PriorityMask[prio])
+  #define PrioListHighest(list)         SAScheduler(list)
+  #define PrioListHighestReady()        SAScheduler(OSReadyList & OSBlockedList)
+  #define PrioListMerge(list, src)      (list) = (list) | (src)
+#endif
+
+/// Ready list and event wait lists of the tasks.
+/// With ROUND_ROBIN_EN the tasks that share a priority are kept in a ready FIFO per priority.
+/// A priority of the ready list has a non empty FIFO, and a priority of a wait list has
+/// at least one waiting task, served in arrival order.
+#if (ROUND_ROBIN_EN == 1)
+  #define OSReadyListAdd(task, prio)            OSReadyInsert((task), (prio))
+  #define OSReadyListRemove(task, prio)         OSReadyDelete((task), (prio))
+  #define OSReadyListMove(task, from, to)       OSReadyMove((task), (from), (to))
+  #define OSReadyListTest(task, prio)           (ContextTask[task].ReadyState & RR_QUEUED)
+  #define OSReadyListBlock(task, prio)          OSReadyBlock((task), (prio))
+  #define OSReadyListUnblock(task, prio)        OSReadyUnblock((task), (prio))
+  #define OSWaitListAdd(list, task, prio)       OSWaitInsert(&(list), (task), (prio))
+  #define OSWaitListRemove(list, task, prio)    OSWaitDelete(&(list), (task), (prio))
+  #define OSWaitListTest(list, task, prio)      (ContextTask[task].WaitList == &(list))
+  #define OSWaitListTask(list, prio)            OSWaitFirst(&(list), (prio))
+  #define OSWaitListWakeAll(list)               OSWaitReadyAll(&(list))
+#else
+  // A priority belongs to a single task: the task is not evaluated
+  #define OSReadyListAdd(task, prio)            ((void)sizeof(task), PrioListAdd(OSReadyList, prio))
+  #define OSReadyListRemove(task, prio)         ((void)sizeof(task), PrioListRemove(OSReadyList, prio))
+  #define OSReadyListMove(task, from, to)       ((void)sizeof(task), PrioListRemove(OSReadyList, from), PrioListAdd(OSReadyList, to))
+  #define OSReadyListTest(task, prio)           (PrioListTest(OSReadyList, prio) && PrioListTest(OSBlockedList, prio))
+  #define OSReadyListBlock(task, prio)          ((void)sizeof(task), PrioListRemove(OSBlockedList, prio))
+  #define OSReadyListUnblock(task, prio)        ((void)sizeof(task), PrioListAdd(OSBlockedList, prio))
+  #define OSWaitListAdd(list, task, prio)       ((void)sizeof(task), PrioListAdd(list, prio))
+  #define OSWaitListRemove(list, task, prio)    ((void)sizeof(task), PrioListRemove(list, prio))
+  #define OSWaitListTest(list, task, prio)      PrioListTest(list, prio)
+  #define OSWaitListTask(list, prio)            PriorityVector[prio]
+  #define OSWaitListWakeAll(list)               do { PrioListMerge(OSReadyList, list); PrioListInit(list); } while(0)
+#endif
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -216,19 +544,85 @@ struct Context
    INT16U StackPoint;       ///< Current position of virtual stack pointer
    INT16U StackInit;        ///< Virtual stack pointer init  
   #endif
-   INT16U TimeToWait;       ///< Time to wait - could be used by delay or timeout
+   TickType TimeToWait;     ///< Time to wait - could be used by delay or timeout
   #if (VERBOSE == 1)
    INT8U  State;            ///< Task states
    INT8U  Blocked;          ///< Task blocked state
    INT8U  SuspendedType;    ///< Task suspended type
   #endif
    INT8U  Priority;         ///< Task priority
+  #if (ROUND_ROBIN_EN == 1)
+   INT8U  ReadyState;       ///< Round-robin ready state (RR_READY, RR_BLOCKED and RR_QUEUED)
+   INT8U  ReadyNext;        ///< Next task of the priority ready FIFO - 0 if none
+   PriorityType *WaitList;  ///< Event wait list of the waiting task - NULL if none
+   INT16U WaitOrder;        ///< Arrival order into the event wait list
+  #endif
+  #if ((TASK_DELETE_EN == 1) || (STACK_WATERMARK_EN == 1))
+   INT16U StackIndex;       ///< First position of the task stack in the STACK heap
+   INT16U StackWords;       ///< Task stack size, in OS_CPU_TYPE words
+  #endif
+  #if (STACK_WATERMARK_EN == 1)
+   INT16U StackUntouched;   ///< Stack words never used by the task (watermark)
+  #endif
+  #if (BRTOS_FLAG_EN == 1)
+   FlagType FlagWait;       ///< Flags waited by the task - receives the flags that released it
+   INT8U  FlagOptions;      ///< Event flags pend options
+  #endif
+  #if (TASK_NOTIFY_EN == 1)
+   INT32U NotifyValue;      ///< Task notification word
+   INT8U  NotifyState;      ///< Task notification state
+  #endif
+  #if (TASK_RESERVATION_EN == 1)
+   void   *Reservation;     ///< Event that keeps a slot to the task until it runs, or NULL
+  #endif
    struct Context *Next;
    struct Context *Previous;
 };
 
 typedef struct Context ContextType;
 
+
+#if (TASK_DELETE_EN == 1)
+/**
+* \struct BRTOS_StackFree
+* Stack region released by a deleted task
+*/
+typedef struct {
+  INT16U       Index;                   ///< First position of the region in the STACK heap
+  INT16U       Words;                   ///< Size of the region, in OS_CPU_TYPE words. Zero = unused entry
+} BRTOS_StackFree;
+#endif
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////    Event Set Control Block Structure             /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+/**
+* \struct BRTOS_Set
+* Event Set Control Block Structure
+*/
+typedef struct {
+  INT8U        OSEventAllocated;              ///< Indicate if the event is allocated or not
+  INT8U        OSEventWait;                   ///< Counter of waiting Tasks
+  INT8U        OSSetCount;                    ///< Number of members
+  INT8U        OSSetNext;                     ///< Member where the next search starts
+  PriorityType OSEventWaitList;               ///< Task wait list for event to occur
+  void         *OSSetSignaled;                ///< Last member posted while there was no task waiting for it
+  void         *OSSetMember[BRTOS_SET_MEMBERS]; ///< Member control blocks
+  INT8U        OSSetType[BRTOS_SET_MEMBERS];  ///< Member types (SET_SEM, SET_MBOX, SET_QUEUE, SET_DQUEUE)
+} BRTOS_Set;
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -256,6 +650,9 @@ typedef struct {
   INT8U		   Binary;						  ///< Defines if semaphore is binary or counting
 #endif
   PriorityType OSEventWaitList;               ///< Task wait list for event to occur
+  #if (BRTOS_SET_EN == 1)
+  BRTOS_Set    *OSEventSet;                   ///< Event set that holds this object, or NULL
+  #endif
 } BRTOS_Sem;
 
 ////////////////////////////////////////////////////////////
@@ -285,6 +682,14 @@ typedef struct {
   INT8U        OSOriginalPriority;            ///< Save original priority of Mutex owner task - used to the priority ceiling implementation
   INT8U        OSEventWait;                   ///< Counter of waiting Tasks
   PriorityType OSEventWaitList;               ///< Task wait list for event to occur
+  #if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+  INT8U        OSRecursive;                   ///< TRUE if the owner may acquire the mutex again
+  INT8U        OSEventCount;                  ///< Nested acquisitions of the mutex owner
+  #endif
+  #if (BRTOS_MUTEX_INHERIT_EN == 1)
+  INT8U        OSInheritPriority;             ///< Priority lent by a waiting task to the mutex owner - 0 if none
+  INT8U        OSInheritTask;                 ///< Task that lent its priority to the mutex owner
+  #endif
 } BRTOS_Mutex;
 
 ////////////////////////////////////////////////////////////
@@ -296,6 +701,128 @@ typedef struct {
 
 
 
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////    Reader-Writer Lock Control Block Structure    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+/**
+* \struct BRTOS_RWLock
+* Reader-Writer Lock Control Block Structure
+*/
+typedef struct {
+  INT8U        OSEventAllocated;              ///< Indicate if the event is allocated or not
+  INT8U        OSMaxPriority;                 ///< Priority ceiling of the lock
+  INT8U        OSRWWriter;                    ///< Task that holds the write lock - 0 if none
+  INT8U        OSRWReaders;                   ///< Number of tasks that hold the read lock
+  INT8U        OSRWReadWait;                  ///< Counter of tasks waiting for the read lock
+  INT8U        OSRWWriteWait;                 ///< Counter of tasks waiting for the write lock
+  INT8U        OSRWBoostTask;                 ///< Task that holds the lock with the priority ceiling - 0 if none
+  INT8U        OSRWBoostOriginal;             ///< Original priority of the task with the priority ceiling
+  INT32U       OSRWReadTasks[TASK_ALLOC_WORDS]; ///< Tasks that hold the read lock - one bit per task
+  PriorityType OSRWReadWaitList;              ///< Task wait list for the read lock
+  PriorityType OSRWWriteWaitList;             ///< Task wait list for the write lock
+} BRTOS_RWLock;
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////    Condition Variable Control Block Structure    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+/**
+* \struct BRTOS_Cond
+* Condition Variable Control Block Structure
+*/
+typedef struct {
+  INT8U        OSEventAllocated;              ///< Indicate if the event is allocated or not
+  INT8U        OSEventWait;                   ///< Counter of waiting Tasks
+  PriorityType OSEventWaitList;               ///< Task wait list for event to occur
+} BRTOS_Cond;
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Barrier Control Block Structure             /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+/**
+* \struct BRTOS_Barrier
+* Barrier Control Block Structure
+*/
+typedef struct {
+  INT8U        OSEventAllocated;              ///< Indicate if the event is allocated or not
+  INT8U        OSBarrierCount;                ///< Number of tasks of the group
+  INT8U        OSBarrierGeneration;           ///< Incremented each time the group is released
+  INT8U        OSEventWait;                   ///< Counter of waiting Tasks
+  PriorityType OSEventWaitList;               ///< Task wait list for the last task to arrive
+} BRTOS_Barrier;
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Work Queue Job Structure                    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+/// Work queue job states
+#define WORK_FREE         0                       ///< The job entry is free
+#define WORK_QUEUED       1                       ///< The job waits for a worker
+#define WORK_DELAYED      2                       ///< The job waits for its delay to expire
+#define WORK_RUNNING      3                       ///< The job is running
+#define WORK_CANCELLED    4                       ///< The job was cancelled while in the job queue
+
+/// Work queue job function type
+typedef void (*FCN_WORK)(void *arg);
+
+/**
+* \struct BRTOS_Work
+* Work Queue Job Structure
+*/
+typedef struct {
+  FCN_WORK     OSWorkFunc;                    ///< Job function
+  void        *OSWorkArg;                     ///< Job function argument
+  TickType     OSWorkStart;                   ///< Tick count when the job was submitted
+  TickType     OSWorkDelay;                   ///< Delay of a delayed job
+  INT8U        OSWorkState;                   ///< Job state
+} BRTOS_Work;
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 /////    MailBox Control Block Structure               /////
@@ -312,6 +839,14 @@ typedef struct {
   INT8U        OSEventState;                  ///< Mailbox state - Defines if the message is available or not
   PriorityType OSEventWaitList;               ///< Task wait list for event to occur
   void         *OSEventPointer;               ///< Pointer to the message structure / type
+  #if (BRTOS_POST_WAIT_EN == 1)
+  INT8U        OSEventSendWait;               ///< Counter of tasks waiting for the message slot
+  INT8U        OSEventSendReserved;           ///< Message slot kept to a released sender
+  PriorityType OSEventSendWaitList;           ///< Task wait list for the message slot
+  #endif
+  #if (BRTOS_SET_EN == 1)
+  BRTOS_Set    *OSEventSet;                   ///< Event set that holds this object, or NULL
+  #endif
 } BRTOS_Mbox;
 
 ////////////////////////////////////////////////////////////
@@ -339,6 +874,14 @@ typedef struct {
   INT8U        OSEventWait;                   ///< Counter of waiting Tasks
   void         *OSEventPointer;               ///< Pointer to queue structure
   PriorityType OSEventWaitList;               ///< Task wait list for event to occur
+  #if (BRTOS_POST_WAIT_EN == 1)
+  INT8U        OSEventSendWait;               ///< Counter of tasks waiting for space in the queue
+  INT8U        OSEventSendReserved;           ///< Slots kept to released senders
+  PriorityType OSEventSendWaitList;           ///< Task wait list for space in the queue
+  #endif
+  #if (BRTOS_SET_EN == 1)
+  BRTOS_Set    *OSEventSet;                   ///< Event set that holds this object, or NULL
+  #endif
 } BRTOS_Queue;
 
 ////////////////////////////////////////////////////////////
@@ -349,6 +892,142 @@ typedef struct {
 
 
 
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////    Shared Object Pool Structure                  /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+/// Object pool entry types
+#define OBJECT_FREE       0                       ///< Free pool entry
+#define OBJECT_SEM        1                       ///< Semaphore control block
+#define OBJECT_MUTEX      2                       ///< Mutex control block
+#define OBJECT_MBOX       3                       ///< Mailbox control block
+#define OBJECT_QUEUE      4                       ///< Queue control block
+
+#if (BRTOS_OBJECT_POOL_EN == 1)
+/**
+* \union BRTOS_Object
+* Shared Object Pool Entry - semaphores, mutexes, mailboxes and queues use the same pool
+*/
+typedef union {
+  INT8U        OSEventAllocated;              ///< First member of all the control blocks
+  #if (BRTOS_SEM_EN == 1)
+  BRTOS_Sem    Sem;                           ///< Semaphore control block
+  #endif
+  #if (BRTOS_MUTEX_EN == 1)
+  BRTOS_Mutex  Mutex;                         ///< Mutex control block
+  #endif
+  #if (BRTOS_MBOX_EN == 1)
+  BRTOS_Mbox   Mbox;                          ///< Mailbox control block
+  #endif
+  #if (BRTOS_QUEUE_EN == 1)
+  BRTOS_Queue  Queue;                         ///< Queue control block
+  #endif
+} BRTOS_Object;
+
+/// Generation tagged handle of a pool entry - entry index in the low byte, entry generation in the high byte
+typedef INT16U BRTOS_Handle;
+
+#define OBJECT_INVALID_HANDLE  (BRTOS_Handle)0xFFFF  ///< Handle that never resolves to an object
+#endif
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////    Memory Pool Control Block Structure           /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+/**
+* \struct BRTOS_MemPool
+* Fixed-block Memory Pool Control Block Structure
+*/
+typedef struct {
+  INT8U        OSEventAllocated;              ///< Indicate if the event is allocated or not
+  INT8U        OSEventWait;                   ///< Counter of waiting Tasks
+  PriorityType OSEventWaitList;               ///< Task wait list for a free block
+  INT8U        *OSMemStart;                   ///< First block of the pool buffer
+  INT8U        *OSMemEnd;                     ///< End of the pool buffer
+  void         *OSMemFreeList;                ///< First free block - each free block points to the next one
+  INT16U       OSMemBlockSize;                ///< Block size in bytes
+  INT16U       OSMemFree;                     ///< Number of free blocks
+  INT16U       OSMemReserved;                 ///< Free blocks kept for the tasks woken by a release
+} BRTOS_MemPool;
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////    Event Flags Control Block Structure           /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+/**
+* \struct BRTOS_Flag
+* Event Flag Group Control Block Structure
+*/
+typedef struct {
+  INT8U        OSEventAllocated;              ///< Indicate if the event is allocated or not
+  INT8U        OSEventWait;                   ///< Counter of waiting Tasks
+  FlagType     OSEventFlags;                  ///< Current flags of the group
+  PriorityType OSEventWaitList;               ///< Task wait list for event to occur
+} BRTOS_Flag;
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////    Stream Buffer Control Block Structure         /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+/**
+* \struct BRTOS_Stream
+* Single Producer / Single Consumer Stream Buffer Control Block Structure
+*/
+typedef struct {
+  INT8U                OSEventAllocated;      ///< Indicate if the event is allocated or not
+  volatile INT8U       *OSStreamBuffer;       ///< Stream data buffer
+  OS_CPU_TYPE          OSStreamSize;          ///< Buffer size in bytes - one byte is always kept empty
+  volatile OS_CPU_TYPE OSStreamIn;            ///< Next byte to write - only changed by the producer
+  volatile OS_CPU_TYPE OSStreamOut;           ///< Next byte to read - only changed by the consumer
+  OS_CPU_TYPE          OSStreamTrigger;       ///< Bytes that release the waiting consumer
+  volatile OS_CPU_TYPE OSStreamLevel;         ///< Bytes waited by the consumer in the current wait
+  volatile INT8U       OSStreamWaiter;        ///< Waiting consumer task, or 0
+} BRTOS_Stream;
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 /////      Queue Structure                             /////
@@ -397,6 +1076,10 @@ typedef struct
   INT16U       OSQTSize;                ///< Size of the queue type - Defined in the create queue function
   INT16U       OSQLength;               ///< Length of the queue - Defined in the create queue function
   INT16U       OSQEntries;              ///< Size of data inside the queue
+  #if (BRTOS_DQUEUE_SLOT_EN == 1)
+  INT8U        OSQReserved;             ///< The input slot is reserved by the producer
+  INT8U        OSQPeeked;               ///< The last output slot is kept by the consumer
+  #endif
 } OS_DQUEUE;
 
 ////////////////////////////////////////////////////////////
@@ -484,6 +1167,9 @@ typedef struct
 * \return NO_MEMORY Not enough memory available to install the task
 * \return END_OF_AVAILABLE_PRIORITIES All the available priorities are busy
 * \return BUSY_PRIORITY Desired priority busy
+*  With ROUND_ROBIN_EN a priority is shared by any number of tasks, and BUSY_PRIORITY means
+*  that the priority is reserved to a mutex or a reader-writer lock.
+*  With TASK_DELETE_EN the stacks released by OSTaskDelete are reused (best-fit).
 *********************************************************************************************/
 #if (TASK_WITH_PARAMETERS == 1)
   INT8U InstallTask(void(*FctPtr)(void*),const CHAR8 *TaskName, INT16U USER_STACKED_BYTES,INT8U iPriority, void *parameters, OS_CPU_TYPE *TaskHandle);
@@ -491,6 +1177,68 @@ typedef struct
   INT8U InstallTask(void(*FctPtr)(void),const CHAR8 *TaskName, INT16U USER_STACKED_BYTES,INT8U iPriority, OS_CPU_TYPE *TaskHandle);
 #endif
 
+#if (TASK_DELETE_EN == 1)
+/*****************************************************************************************//**
+* \fn INT8U OSTaskDelete(BRTOS_TH iTaskNumber)
+* \brief Uninstall a task. The task control block, the priority and the stack are released.
+*  The task is removed from the delay list and from the semaphore, mutex, mailbox and
+*  queue wait lists. A task can delete itself.
+* \param iTaskNumber Task handle id
+* \return OK Task successfully deleted
+* \return IRQ_PEND_ERR Can not be called inside an interrupt
+* \return NOT_VALID_TASK The task handle is not an installed task
+* \return TASK_OWNS_MUTEX The task owns a mutex or a reader-writer lock and must release it first
+* \return BUSY_PRIORITY The task priority is lent to a mutex owner waiting for other event
+*********************************************************************************************/
+INT8U OSTaskDelete(BRTOS_TH iTaskNumber);
+#endif
+
+#if (STACK_WATERMARK_EN == 1)
+/*****************************************************************************************//**
+* \fn INT16U OSTaskStackHighWater(BRTOS_TH iTaskNumber)
+* \brief Returns the maximum stack use of a task, in bytes.
+*  The value is cached. The idle task refreshes it a few stack words at a time.
+* \param iTaskNumber Task handle id. The idle task is NUMBER_OF_TASKS+1
+* \return Maximum stack use measured until now, or 0 for an invalid handle
+*********************************************************************************************/
+INT16U OSTaskStackHighWater(BRTOS_TH iTaskNumber);
+
+/*****************************************************************************************//**
+* \fn void OSStackWatermarkUpdate(void)
+* \brief Verifies STACK_WATERMARK_STEP words of a task stack (Internal kernel function).
+*  Called by the idle task. The tasks are verified one after the other.
+* \return NONE
+*********************************************************************************************/
+void OSStackWatermarkUpdate(void);
+#endif
+
+#if (TASK_NOTIFY_EN == 1)
+/*****************************************************************************************//**
+* \fn INT8U OSTaskNotify(BRTOS_TH iTaskNumber, INT32U value, INT8U action)
+* \brief Updates the notification word of a task and releases the task if it is waiting.
+*  May be used inside interrupt handlers.
+* \param iTaskNumber Task handle id
+* \param value Notification value
+* \param action NOTIFY_SET_BITS, NOTIFY_INCREMENT or NOTIFY_OVERWRITE
+* \return OK Success
+* \return NOT_VALID_TASK Invalid handle or task not installed
+* \return INVALID_PARAMETERS Invalid action
+*********************************************************************************************/
+INT8U OSTaskNotify(BRTOS_TH iTaskNumber, INT32U value, INT8U action);
+
+/*****************************************************************************************//**
+* \fn INT8U OSTaskNotifyWait(INT32U *value, TickType time_wait)
+* \brief Waits for a notification to the current task.
+*  The notification word is read and cleared.
+* \param *value Receives the notification word - may be NULL
+* \param time_wait Timeout to the notification wait exits - 0 waits forever
+* \return OK Success
+* \return TIMEOUT There was no notification in the specified time
+* \return IRQ_PEND_ERR Can not use notification wait function from interrupt handler code
+*********************************************************************************************/
+INT8U OSTaskNotifyWait(INT32U *value, TickType time_wait);
+#endif
+
 /*****************************************************************************************//**
 * \fn INT8U InstallIdle(void(*FctPtr)(void), INT16U USER_STACKED_BYTES)
 * \brief Install the idle task. Initial state = running.
@@ -551,7 +1299,7 @@ void OS_TICK_HANDLER(void);
 INT8U BRTOSStart(void);
 
 /*****************************************************************************************//**
-* \fn INT8U DelayTask(INT16U time)
+* \fn INT8U DelayTask(TickType time)
 * \brief Wait for a specified period.
 *  A task that calling this function will be suspended for a certain time.
 *  When this time is reached the task back to ready state.
@@ -559,7 +1307,7 @@ INT8U BRTOSStart(void);
 * \return OK Success
 * \return IRQ_PEND_ERR - Can not use block priority function from interrupt handler code
 *********************************************************************************************/
-INT8U DelayTask(INT16U time);
+INT8U DelayTask(TickType time);
 
 /*****************************************************************************************//**
 * \fn INT8U DelayTaskHMSM(INT8U hours, INT8U minutes, INT8U seconds, INT16U miliseconds)
@@ -576,20 +1324,20 @@ INT8U DelayTask(INT16U time);
 INT8U DelayTaskHMSM(INT8U hours, INT8U minutes, INT8U seconds, INT16U miliseconds);
 
 /*****************************************************************************************//**
-* \fn INT16U OSGetTickCount(INT16U time)
+* \fn TickType OSGetTickCount(void)
 * \brief Return current tick count.
 *  The user must call this function in order to receive the current tick count.
 * \return current tick count
 *********************************************************************************************/
-INT16U OSGetTickCount(void);
+TickType OSGetTickCount(void);
 
 /*****************************************************************************************//**
-* \fn INT16U OSGetCount(INT16U time)
+* \fn TickType OSGetCount(void)
 * \brief Return current tick count.
 *  Internal BRTOS function.
 * \return current tick count
 *********************************************************************************************/
-INT16U OSGetCount(void);
+TickType OSGetCount(void);
 
 /*****************************************************************************************//**
 * \fn void OSIncCounter(void)
@@ -598,6 +1346,35 @@ INT16U OSGetCount(void);
 *********************************************************************************************/
 void OSIncCounter(void);
 
+/*****************************************************************************************//**
+* \fn TickType OSWakeTimeCompute(TickType time_wait)
+* \brief Compute the tick count of a delay or timeout expiration (Internal kernel function).
+*  Must be called inside a critical section.
+* \param time_wait Time in ticks to wait from now
+* \return Tick count when the time expires
+*********************************************************************************************/
+TickType OSWakeTimeCompute(TickType time_wait);
+
+/*****************************************************************************************//**
+* \fn void OSDelayListInsert(ContextType *Task)
+* \brief Insert a task into the delay list, ordered by wake time (Internal kernel function).
+*  The list head is always the next timeout to expire. Must be called inside a critical section.
+* \param *Task Task context with the TimeToWait field already filled
+* \return NONE
+*********************************************************************************************/
+void OSDelayListInsert(ContextType *Task);
+
+/*****************************************************************************************//**
+* \fn void OSTicklessIdle(void)
+* \brief Put the processor in sleep mode without tick interrupts (Internal kernel function).
+*  Called by the idle task. The tick timer is stopped until the next timeout in the delay list
+*  and the tick counter is advanced by the suppressed ticks when the processor wakes up.
+* \return NONE
+*********************************************************************************************/
+#if (TICKLESS_IDLE_EN == 1)
+void OSTicklessIdle(void);
+#endif
+
 /*****************************************************************************************//**
 * \fn void PreInstallTasks(void)
 * \brief Function that initialize the kernel main variables.
@@ -681,12 +1458,207 @@ void BRTOS_Init(void);
 INT8U OSSchedule(void);
 
 /*****************************************************************//**
-* \fn INT8U SAScheduler(PriorityType ReadyList)
+* \fn INT8U SAScheduler(PriorityBits ReadyList)
 * \brief Sucessive Aproximation Scheduler (Internal kernel function).
+*        The lookup method is selected by OPTIMIZED_SCHEDULER in HAL.h.
 * \param ReadyList List of the tasks ready to run
 * \return The priority of the highest priority task ready to run
 *********************************************************************/
-INT8U SAScheduler(PriorityType ReadyList);
+INT8U SAScheduler(PriorityBits ReadyList);
+
+#if (NUMBER_OF_PRIORITIES > 32)
+/*****************************************************************************************//**
+* \fn void OSPrioListInit(PriorityType *list)
+* \brief Empties a two-level priority list (Internal kernel function).
+* \param *list Priority list
+* \return NONE
+*********************************************************************************************/
+void OSPrioListInit(PriorityType *list);
+
+/*****************************************************************************************//**
+* \fn void OSPrioListAdd(PriorityType *list, INT8U iPriority)
+* \brief Includes a priority into a two-level priority list (Internal kernel function).
+* \param *list Priority list
+* \param iPriority Priority to be included
+* \return NONE
+*********************************************************************************************/
+void OSPrioListAdd(PriorityType *list, INT8U iPriority);
+
+/*****************************************************************************************//**
+* \fn void OSPrioListRemove(PriorityType *list, INT8U iPriority)
+* \brief Removes a priority from a two-level priority list (Internal kernel function).
+* \param *list Priority list
+* \param iPriority Priority to be removed
+* \return NONE
+*********************************************************************************************/
+void OSPrioListRemove(PriorityType *list, INT8U iPriority);
+
+/*****************************************************************************************//**
+* \fn INT8U OSPrioListHighest(PriorityType *list)
+* \brief Finds the highest priority of a non empty two-level priority list (Internal kernel function).
+* \param *list Priority list
+* \return The highest priority of the list
+*********************************************************************************************/
+INT8U OSPrioListHighest(PriorityType *list);
+
+/*****************************************************************************************//**
+* \fn INT8U OSPrioListHighestReady(void)
+* \brief Finds the highest priority that is ready and not blocked (Internal kernel function).
+* \return The highest priority ready to run
+*********************************************************************************************/
+INT8U OSPrioListHighestReady(void);
+
+/*****************************************************************************************//**
+* \fn void OSPrioListMerge(PriorityType *list, PriorityType *src)
+* \brief Includes all the priorities of a list into other two-level priority list (Internal kernel function).
+* \param *list Priority list
+* \param *src Priorities to be included
+* \return NONE
+*********************************************************************************************/
+void OSPrioListMerge(PriorityType *list, PriorityType *src);
+#endif
+
+#if (ROUND_ROBIN_EN == 1)
+/*****************************************************************************************//**
+* \fn void OSReadyInsert(INT8U iTask, INT8U iPriority)
+* \brief Includes a task that is not waiting anymore at the tail of its priority ready FIFO
+*  (Internal kernel function). A blocked task is included when unblocked.
+* \param iTask Task number
+* \param iPriority Priority of the task
+* \return NONE
+*********************************************************************************************/
+void OSReadyInsert(INT8U iTask, INT8U iPriority);
+
+/*****************************************************************************************//**
+* \fn void OSReadyDelete(INT8U iTask, INT8U iPriority)
+* \brief Removes a task that waits for a delay or an event from its priority ready FIFO (Internal kernel function).
+* \param iTask Task number
+* \param iPriority Priority of the task
+* \return NONE
+*********************************************************************************************/
+void OSReadyDelete(INT8U iTask, INT8U iPriority);
+
+/*****************************************************************************************//**
+* \fn void OSReadyMove(INT8U iTask, INT8U from, INT8U to)
+* \brief Moves a ready task to the tail of the ready FIFO of other priority (Internal kernel function).
+*  The caller updates the task priority.
+* \param iTask Task number
+* \param from Current priority of the task
+* \param to New priority of the task
+* \return NONE
+*********************************************************************************************/
+void OSReadyMove(INT8U iTask, INT8U from, INT8U to);
+
+/*****************************************************************************************//**
+* \fn void OSReadyBlock(INT8U iTask, INT8U iPriority)
+* \brief Removes a blocked task from its priority ready FIFO (Internal kernel function).
+* \param iTask Task number
+* \param iPriority Priority of the task
+* \return NONE
+*********************************************************************************************/
+void OSReadyBlock(INT8U iTask, INT8U iPriority);
+
+/*****************************************************************************************//**
+* \fn void OSReadyUnblock(INT8U iTask, INT8U iPriority)
+* \brief Includes an unblocked task into its priority ready FIFO if it is not waiting (Internal kernel function).
+* \param iTask Task number
+* \param iPriority Priority of the task
+* \return NONE
+*********************************************************************************************/
+void OSReadyUnblock(INT8U iTask, INT8U iPriority);
+
+/*****************************************************************************************//**
+* \fn void OSWaitInsert(PriorityType *list, INT8U iTask, INT8U iPriority)
+* \brief Includes a task at the tail of an event wait list (Internal kernel function).
+* \param *list Event wait list
+* \param iTask Task number
+* \param iPriority Priority of the task
+* \return NONE
+*********************************************************************************************/
+void OSWaitInsert(PriorityType *list, INT8U iTask, INT8U iPriority);
+
+/*****************************************************************************************//**
+* \fn void OSWaitDelete(PriorityType *list, INT8U iTask, INT8U iPriority)
+* \brief Removes a task from an event wait list (Internal kernel function).
+*  The priority stays in the list while other task of the same priority is waiting.
+* \param *list Event wait list
+* \param iTask Task number
+* \param iPriority Priority of the task
+* \return NONE
+*********************************************************************************************/
+void OSWaitDelete(PriorityType *list, INT8U iTask, INT8U iPriority);
+
+/*****************************************************************************************//**
+* \fn INT8U OSWaitFirst(PriorityType *list, INT8U iPriority)
+* \brief Finds the first task of a priority that arrived into an event wait list (Internal kernel function).
+* \param *list Event wait list
+* \param iPriority Priority of the task
+* \return The task number, or 0 if no task of this priority is waiting
+*********************************************************************************************/
+INT8U OSWaitFirst(PriorityType *list, INT8U iPriority);
+
+/*****************************************************************************************//**
+* \fn INT8U OSWaitNext(PriorityType *list, INT8U iTask)
+* \brief Finds the task of an event wait list that is released after other task (Internal kernel function).
+*  The tasks are released from the highest to the lowest priority, in arrival order inside a priority.
+* \param *list Event wait list
+* \param iTask Task number, or 0 to find the first task released
+* \return The task number, or 0 if there is no other task
+*********************************************************************************************/
+INT8U OSWaitNext(PriorityType *list, INT8U iTask);
+
+/*****************************************************************************************//**
+* \fn void OSWaitReadyAll(PriorityType *list)
+* \brief Includes all the tasks of an event wait list into the ready FIFOs, in arrival order,
+*  and empties the wait list (Internal kernel function).
+* \param *list Event wait list
+* \return NONE
+*********************************************************************************************/
+void OSWaitReadyAll(PriorityType *list);
+
+/*****************************************************************************************//**
+* \fn INT8U OSTimeSliceRotate(INT8U iTask)
+* \brief Moves a task to the tail of its priority ready FIFO, giving the time slice to the next
+*  task of the same priority (Internal kernel function). Must be called inside a critical section.
+* \param iTask Task that releases the time slice
+* \return TRUE if other task received the time slice
+*********************************************************************************************/
+INT8U OSTimeSliceRotate(INT8U iTask);
+
+/*****************************************************************************************//**
+* \fn INT8U OSYield(void)
+* \brief Gives the processor to the next ready task with the same priority.
+*  The current task keeps running if there is no other task ready with its priority.
+* \return OK Success
+* \return IRQ_PEND_ERR Can not be called from interrupt handler code
+* \return NOT_VALID_TASK Called before the scheduler start
+*********************************************************************************************/
+INT8U OSYield(void);
+#endif
+
+#if (BRTOS_SCHED_LOCK_EN == 1)
+/*****************************************************************************************//**
+* \fn INT8U OSSchedLock(void)
+* \brief Locks the scheduler. Nestable, up to 255 levels.
+*  Interrupts stay enabled and may ready tasks, but the context switches are deferred
+*  until the last OSSchedUnlock(). The functions that may block the task return
+*  SCHED_LOCK_PEND_ERR while the lock is held. A task that deletes itself releases the lock.
+* \return OK Success
+* \return IRQ_PEND_ERR Can not be called from interrupt handler code
+* \return NOT_VALID_TASK Called before the scheduler start
+* \return SCHED_LOCK_OVF Lock nesting overflow
+*********************************************************************************************/
+INT8U OSSchedLock(void);
+
+/*****************************************************************************************//**
+* \fn INT8U OSSchedUnlock(void)
+* \brief Unlocks the scheduler. The last unlock switches to the highest priority ready task.
+* \return OK Success
+* \return IRQ_PEND_ERR Can not be called from interrupt handler code
+* \return SCHED_NOT_LOCKED The scheduler is not locked
+*********************************************************************************************/
+INT8U OSSchedUnlock(void);
+#endif
 
 
 
@@ -696,26 +1668,93 @@ INT8U SAScheduler(PriorityType ReadyList);
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-#if (BRTOS_SEM_EN == 1)
+#if ((BRTOS_SEM_EN == 1) && (BRTOS_OBJECT_POOL_EN == 0))
   /// Semahore Control Block
   extern BRTOS_Sem BRTOS_Sem_Table[BRTOS_MAX_SEM];
 #endif
 
-#if (BRTOS_MUTEX_EN == 1)
+#if ((BRTOS_MUTEX_EN == 1) && (BRTOS_OBJECT_POOL_EN == 0))
   /// Mutex Control Block
   extern BRTOS_Mutex BRTOS_Mutex_Table[BRTOS_MAX_MUTEX];
 #endif
 
-#if (BRTOS_MBOX_EN == 1)
+#if ((BRTOS_MBOX_EN == 1) && (BRTOS_OBJECT_POOL_EN == 0))
   /// MailBox Control Block
   extern BRTOS_Mbox BRTOS_Mbox_Table[BRTOS_MAX_MBOX];
 #endif
 
-#if (BRTOS_QUEUE_EN == 1)
+#if ((BRTOS_QUEUE_EN == 1) && (BRTOS_OBJECT_POOL_EN == 0))
   /// Queue Control Block
   extern BRTOS_Queue BRTOS_Queue_Table[BRTOS_MAX_QUEUE];
 #endif
 
+#if (BRTOS_OBJECT_POOL_EN == 1)
+  /// Shared Object Pool
+  extern BRTOS_Object BRTOS_Object_Table[BRTOS_MAX_OBJECTS];
+  extern INT8U        BRTOS_Object_Type[BRTOS_MAX_OBJECTS];
+  extern INT8U        BRTOS_Object_Gen[BRTOS_MAX_OBJECTS];
+
+  /// Control block tables seen by the kernel - pool entries of other types are NULL
+  #define SEM_ENTRIES         BRTOS_MAX_OBJECTS
+  #define SemEntry(i)         ((BRTOS_Sem*)OSObjectGet(OBJECT_SEM, (i)))
+  #define MUTEX_ENTRIES       BRTOS_MAX_OBJECTS
+  #define MutexEntry(i)       ((BRTOS_Mutex*)OSObjectGet(OBJECT_MUTEX, (i)))
+  #define MBOX_ENTRIES        BRTOS_MAX_OBJECTS
+  #define MboxEntry(i)        ((BRTOS_Mbox*)OSObjectGet(OBJECT_MBOX, (i)))
+  #define QUEUE_ENTRIES       BRTOS_MAX_OBJECTS
+  #define QueueEntry(i)       ((BRTOS_Queue*)OSObjectGet(OBJECT_QUEUE, (i)))
+
+  /// Verifies that a control block pointer is a created object of the given type
+  #define OSObjectCreated(event, type)  OSObjectCheck((void*)(event), (type))
+#else
+  #define SEM_ENTRIES         BRTOS_MAX_SEM
+  #define SemEntry(i)         (&BRTOS_Sem_Table[i])
+  #define MUTEX_ENTRIES       BRTOS_MAX_MUTEX
+  #define MutexEntry(i)       (&BRTOS_Mutex_Table[i])
+  #define MBOX_ENTRIES        BRTOS_MAX_MBOX
+  #define MboxEntry(i)        (&BRTOS_Mbox_Table[i])
+  #define QUEUE_ENTRIES       BRTOS_MAX_QUEUE
+  #define QueueEntry(i)       (&BRTOS_Queue_Table[i])
+
+  /// Verifies that a control block pointer is a created object of the given type
+  #define OSObjectCreated(event, type)  ((event)->OSEventAllocated == TRUE)
+#endif
+
+#if (BRTOS_MEMPOOL_EN == 1)
+  /// Memory Pool Control Block
+  extern BRTOS_MemPool BRTOS_MemPool_Table[BRTOS_MAX_MEMPOOL];
+#endif
+
+#if (BRTOS_FLAG_EN == 1)
+  /// Event Flags Control Block
+  extern BRTOS_Flag BRTOS_Flag_Table[BRTOS_MAX_FLAG];
+#endif
+
+#if (BRTOS_STREAM_EN == 1)
+  /// Stream Buffer Control Block
+  extern BRTOS_Stream BRTOS_Stream_Table[BRTOS_MAX_STREAM];
+#endif
+
+#if (BRTOS_SET_EN == 1)
+  /// Event Set Control Block
+  extern BRTOS_Set BRTOS_Set_Table[BRTOS_MAX_SET];
+#endif
+
+#if (BRTOS_RWLOCK_EN == 1)
+  /// Reader-Writer Lock Control Block
+  extern BRTOS_RWLock BRTOS_RWLock_Table[BRTOS_MAX_RWLOCK];
+#endif
+
+#if (BRTOS_COND_EN == 1)
+  /// Condition Variable Control Block
+  extern BRTOS_Cond BRTOS_Cond_Table[BRTOS_MAX_COND];
+#endif
+
+#if (BRTOS_BARRIER_EN == 1)
+  /// Barrier Control Block
+  extern BRTOS_Barrier BRTOS_Barrier_Table[BRTOS_MAX_BARRIER];
+#endif
+
 
 /*****************************************************************************************//**
 * \fn void initEvents(void)
@@ -725,6 +1764,68 @@ INT8U SAScheduler(PriorityType ReadyList);
 void initEvents(void);
 
 
+#if (BRTOS_OBJECT_POOL_EN == 1)
+  /*****************************************************************************************//**
+  * \fn void *OSObjectAlloc(INT8U type)
+  * \brief Takes a control block from the shared object pool (Internal kernel function)
+  *  Constant time - the free entries are kept in a list. Must be called inside a critical section.
+  * \param type OBJECT_SEM, OBJECT_MUTEX, OBJECT_MBOX or OBJECT_QUEUE
+  * \return Control block pointer, or NULL if the pool is empty
+  *********************************************************************************************/
+  void *OSObjectAlloc(INT8U type);
+
+  /*****************************************************************************************//**
+  * \fn void OSObjectFree(void *object)
+  * \brief Gives a control block back to the shared object pool (Internal kernel function)
+  *  Constant time. A control block that is already free is not inserted twice.
+  *  Must be called inside a critical section.
+  * \param *object Control block pointer
+  * \return NONE
+  *********************************************************************************************/
+  void OSObjectFree(void *object);
+
+  /*****************************************************************************************//**
+  * \fn void *OSObjectGet(INT8U type, INT8U index)
+  * \brief Returns a pool entry if it holds a control block of the given type (Internal kernel function)
+  * \param type OBJECT_SEM, OBJECT_MUTEX, OBJECT_MBOX or OBJECT_QUEUE
+  * \param index Pool entry
+  * \return Control block pointer, or NULL
+  *********************************************************************************************/
+  void *OSObjectGet(INT8U type, INT8U index);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSObjectCheck(void *object, INT8U type)
+  * \brief Verifies a control block pointer against the shared object pool (Internal kernel function)
+  *  A stale pointer to a pool entry that was reused by another object type is not valid.
+  *  A pointer can not tell an entry reused by the same type - OSObjectResolve() can.
+  * \param *object Control block pointer
+  * \param type OBJECT_SEM, OBJECT_MUTEX, OBJECT_MBOX or OBJECT_QUEUE
+  * \return TRUE if the pointer is a created object of the given type
+  *********************************************************************************************/
+  INT8U OSObjectCheck(void *object, INT8U type);
+
+  /*****************************************************************************************//**
+  * \fn BRTOS_Handle OSObjectHandle(void *object)
+  * \brief Returns the generation tagged handle of a created object
+  *  Tasks that share an object which may be deleted keep the handle instead of the pointer.
+  *  The generation of a pool entry changes each time the entry is freed.
+  * \param *object Control block pointer returned by the create function
+  * \return Object handle, or OBJECT_INVALID_HANDLE if the pointer is not a pool entry
+  *********************************************************************************************/
+  BRTOS_Handle OSObjectHandle(void *object);
+
+  /*****************************************************************************************//**
+  * \fn void *OSObjectResolve(BRTOS_Handle handle, INT8U type)
+  * \brief Returns the control block pointer of an object handle
+  *  A handle of a deleted object does not resolve, even if its entry holds a new object of the same type.
+  * \param handle Object handle returned by OSObjectHandle()
+  * \param type OBJECT_SEM, OBJECT_MUTEX, OBJECT_MBOX or OBJECT_QUEUE
+  * \return Control block pointer, or NULL if the object was deleted
+  *********************************************************************************************/
+  void *OSObjectResolve(BRTOS_Handle handle, INT8U type);
+#endif
+
+
 #if (BRTOS_SEM_EN == 1)
 
   /*****************************************************************************************//**
@@ -761,7 +1862,7 @@ void initEvents(void);
   INT8U OSSemDelete (BRTOS_Sem **event);
 
   /*****************************************************************************************//**
-  * \fn INT8U OSSemPend (BRTOS_Sem *pont_event, INT16U timeout)
+  * \fn INT8U OSSemPend (BRTOS_Sem *pont_event, TickType timeout)
   * \brief Wait for a semaphore post
   *  Semaphore pend may be used to syncronize tasks or wait for an event occurs.
   *  A task exits a pending state with a semaphore post or by timeout.
@@ -772,7 +1873,7 @@ void initEvents(void);
   * \return IRQ_PEND_ERR Can not use semaphore pend function from interrupt handler code
   * \return NO_EVENT_SLOT_AVAILABLE Full Event list
   *********************************************************************************************/
-  INT8U OSSemPend (BRTOS_Sem *pont_event, INT16U timeout);
+  INT8U OSSemPend (BRTOS_Sem *pont_event, TickType timeout);
   
   /*****************************************************************************************//**
   * \fn INT8U OSSemPost(BRTOS_Sem *pont_event)
@@ -790,13 +1891,31 @@ void initEvents(void);
   * \fn INT8U OSMutexCreate (BRTOS_Mutex **event, INT8U HigherPriority)
   * \brief Allocates a mutex control block
   * \param **event Address of the mutex control block pointer
-  * \param HigherPriority Higher priority of the tasks that will share a resource
+  * \param HigherPriority Higher priority of the tasks that will share a resource (priority ceiling)\n
+  *  MUTEX_INHERIT creates a priority inheritance mutex, that does not reserve a priority.
+  *  Its owner receives the priority of the highest waiting task while it is ready to run.
   * \return IRQ_PEND_ERR Can not use mutex create function from interrupt handler code
+  * \return BUSY_PRIORITY The priority ceiling is used by a task or by other mutex
   * \return NO_AVAILABLE_EVENT No mutex control blocks available
   * \return ALLOC_EVENT_OK Mutex control block successfully allocated
   *********************************************************************************************/
   INT8U OSMutexCreate (BRTOS_Mutex **event, INT8U HigherPriority);
   
+  #if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+  /*****************************************************************************************//**
+  * \fn INT8U OSMutexCreateRecursive (BRTOS_Mutex **event, INT8U HigherPriority)
+  * \brief Allocates a recursive mutex control block
+  *  The owner of a recursive mutex may acquire it again. Each acquisition needs a release.
+  * \param **event Address of the mutex control block pointer
+  * \param HigherPriority Priority ceiling, or MUTEX_INHERIT, as in OSMutexCreate
+  * \return IRQ_PEND_ERR Can not use mutex create function from interrupt handler code
+  * \return BUSY_PRIORITY The priority ceiling is used by a task or by other mutex
+  * \return NO_AVAILABLE_EVENT No mutex control blocks available
+  * \return ALLOC_EVENT_OK Mutex control block successfully allocated
+  *********************************************************************************************/
+  INT8U OSMutexCreateRecursive (BRTOS_Mutex **event, INT8U HigherPriority);
+  #endif
+  
   /*****************************************************************************************//**
   * \fn INT8U OSMutexDelete (BRTOS_Mutex **event)
   * \brief Releases a mutex control block
@@ -811,9 +1930,11 @@ void initEvents(void);
   * \brief Wait for a mutex release
   *  Mutex release may be used to manage shared resources, for exemple, a LCD.
   *  A acquired state exits with a mutex owner release
+  *  The owner of a recursive mutex may acquire it again. Each acquisition needs a release.
   * \param *pont_event Mutex pointer
   * \return OK Success
   * \return IRQ_PEND_ERR Can not use mutex pend function from interrupt handler code
+  * \return ERR_MUTEX_OVF Mutex counter overflow - too many nested acquisitions
   * \return NO_EVENT_SLOT_AVAILABLE Full Event list
   *********************************************************************************************/
   INT8U OSMutexAcquire(BRTOS_Mutex *pont_event);
@@ -823,12 +1944,199 @@ void initEvents(void);
   * \brief Release Mutex
   *  Mutex release must be used to release a shared resource.
   *  Only the mutex owner can executed the mutex post function with success.
+  *  A recursive mutex is only released by the release of the first acquisition.
   * \param *pont_event Mutex pointer
   * \return OK Success
   * \return ERR_EVENT_OWNER The function caller is not the mutex owner
   * \return ERR_MUTEX_OVF Mutex counter overflow
   *********************************************************************************************/  
   INT8U OSMutexRelease(BRTOS_Mutex *pont_event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSMutexGive(BRTOS_Mutex *pont_event)
+  * \brief Releases the mutex owned by the current task (Internal kernel function)
+  *  Restores the owner priority and gives the mutex to the highest priority waiting task.
+  *  Must be called inside a critical section. Does not change the context.
+  * \param *pont_event Mutex pointer
+  * \return TRUE if a waiting task was released
+  *********************************************************************************************/
+  INT8U OSMutexGive(BRTOS_Mutex *pont_event);
+
+  #if (BRTOS_MUTEX_INHERIT_EN == 1)
+  /*****************************************************************************************//**
+  * \fn void OSMutexInherit(BRTOS_Mutex *pont_event, INT8U owner)
+  * \brief Updates the priority of a priority inheritance mutex owner (Internal kernel function)
+  *  The owner runs with the priority of the highest task waiting for its inheritance mutexes,
+  *  or with its original priority. Must be called inside a critical section.
+  * \param *pont_event Mutex owned or just released by the owner task
+  * \param owner Owner task number
+  *********************************************************************************************/
+  void OSMutexInherit(BRTOS_Mutex *pont_event, INT8U owner);
+  
+  /*****************************************************************************************//**
+  * \fn void OSMutexInheritUpdate(void)
+  * \brief Updates the priority of the inheritance mutex owners (Internal kernel function)
+  *  The priority of an owner waiting for other event only changes when it is ready to run.
+  *  Called by the scheduler while OSMutexInheritPending is set. Must be called inside a
+  *  critical section.
+  *********************************************************************************************/
+  void OSMutexInheritUpdate(void);
+  #endif
+#endif
+
+#if (BRTOS_RWLOCK_EN == 1)
+  /*****************************************************************************************//**
+  * \fn INT8U OSRWLockCreate (BRTOS_RWLock **event, INT8U HigherPriority)
+  * \brief Allocates a reader-writer lock control block
+  * \param **event Address of the lock control block pointer
+  * \param HigherPriority Priority ceiling - used by a task that holds the lock while other tasks wait for it
+  * \return IRQ_PEND_ERR Can not use lock create function from interrupt handler code
+  * \return BUSY_PRIORITY The priority ceiling is used by a task or by other event
+  * \return NO_AVAILABLE_EVENT No lock control blocks available
+  * \return ALLOC_EVENT_OK Lock control block successfully allocated
+  *********************************************************************************************/
+  INT8U OSRWLockCreate (BRTOS_RWLock **event, INT8U HigherPriority);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSRWLockDelete (BRTOS_RWLock **event)
+  * \brief Releases a reader-writer lock control block and its priority ceiling
+  * \param **event Address of the lock control block pointer
+  * \return IRQ_PEND_ERR Can not use lock delete function from interrupt handler code
+  * \return DELETE_EVENT_OK Lock control block released with success
+  *********************************************************************************************/
+  INT8U OSRWLockDelete (BRTOS_RWLock **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSRWLockAcquireRead(BRTOS_RWLock *pont_event, TickType time_wait)
+  * \brief Acquires the lock shared with other readers
+  *  A reader waits while a writer holds the lock or waits for it.
+  * \param *pont_event Lock pointer
+  * \param time_wait Timeout to the lock acquire - 0 waits forever
+  * \return OK Success - also if the task already holds the lock
+  * \return TIMEOUT The lock was not acquired in the specified time
+  * \return IRQ_PEND_ERR Can not use lock acquire function from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSRWLockAcquireRead(BRTOS_RWLock *pont_event, TickType time_wait);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSRWLockAcquireWrite(BRTOS_RWLock *pont_event, TickType time_wait)
+  * \brief Acquires the lock exclusively
+  *  The writer waits until the readers release the lock. New readers wait for the writer.
+  * \param *pont_event Lock pointer
+  * \param time_wait Timeout to the lock acquire - 0 waits forever
+  * \return OK Success - also if the task already holds the write lock
+  * \return TIMEOUT The lock was not acquired in the specified time
+  * \return BUSY_RESOURCE The task holds the read lock and would wait for itself
+  * \return IRQ_PEND_ERR Can not use lock acquire function from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSRWLockAcquireWrite(BRTOS_RWLock *pont_event, TickType time_wait);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSRWLockRelease(BRTOS_RWLock *pont_event)
+  * \brief Releases the read or the write lock held by the current task
+  * \param *pont_event Lock pointer
+  * \return OK Success
+  * \return ERR_EVENT_OWNER The function caller does not hold the lock
+  * \return IRQ_PEND_ERR Can not use lock release function from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSRWLockRelease(BRTOS_RWLock *pont_event);
+  
+  /*****************************************************************************************//**
+  * \fn void OSRWLockUpdate(void)
+  * \brief Gives the priority ceiling to the lock holders (Internal kernel function)
+  *  The priority of a holder waiting for other event only changes when it is ready to run.
+  *  Called by the scheduler while OSRWLockBoostPending is set. Must be called inside a
+  *  critical section.
+  *********************************************************************************************/
+  void OSRWLockUpdate(void);
+#endif
+
+#if ((BRTOS_COND_EN == 1) && (BRTOS_MUTEX_EN == 1))
+  /*****************************************************************************************//**
+  * \fn INT8U OSCondCreate (BRTOS_Cond **event)
+  * \brief Allocates a condition variable control block
+  * \param **event Address of the condition variable control block pointer
+  * \return IRQ_PEND_ERR Can not use condition variable create function from interrupt handler code
+  * \return NO_AVAILABLE_EVENT No condition variable control blocks available
+  * \return ALLOC_EVENT_OK Condition variable control block successfully allocated
+  *********************************************************************************************/
+  INT8U OSCondCreate (BRTOS_Cond **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSCondDelete (BRTOS_Cond **event)
+  * \brief Releases a condition variable control block
+  * \param **event Address of the condition variable control block pointer
+  * \return IRQ_PEND_ERR Can not use condition variable delete function from interrupt handler code
+  * \return DELETE_EVENT_OK Condition variable control block released with success
+  *********************************************************************************************/
+  INT8U OSCondDelete (BRTOS_Cond **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSCondWait (BRTOS_Cond *pont_event, BRTOS_Mutex *mutex, TickType time_wait)
+  * \brief Releases the mutex and waits for a signal, in one atomic operation
+  *  The task owns the mutex again when the function returns, also after a timeout.
+  * \param *pont_event Condition variable pointer
+  * \param *mutex Mutex owned by the current task
+  * \param time_wait Timeout to the signal - 0 waits forever
+  * \return OK Success
+  * \return TIMEOUT There was no signal in the specified time
+  * \return ERR_EVENT_OWNER The current task does not own the mutex
+  * \return IRQ_PEND_ERR Can not use condition variable wait function from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSCondWait (BRTOS_Cond *pont_event, BRTOS_Mutex *mutex, TickType time_wait);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSCondSignal(BRTOS_Cond *pont_event)
+  * \brief Releases the highest priority task waiting for the condition
+  * \param *pont_event Condition variable pointer
+  * \return OK Success - also if there is no waiting task
+  *********************************************************************************************/
+  INT8U OSCondSignal(BRTOS_Cond *pont_event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSCondBroadcast(BRTOS_Cond *pont_event)
+  * \brief Releases all the tasks waiting for the condition
+  *  The wait list is merged into the ready list at once, with one context switch.
+  * \param *pont_event Condition variable pointer
+  * \return OK Success - also if there is no waiting task
+  *********************************************************************************************/
+  INT8U OSCondBroadcast(BRTOS_Cond *pont_event);
+#endif
+
+#if (BRTOS_BARRIER_EN == 1)
+  /*****************************************************************************************//**
+  * \fn INT8U OSBarrierCreate (INT8U count, BRTOS_Barrier **event)
+  * \brief Allocates a barrier control block
+  * \param count Number of tasks of the group
+  * \param **event Address of the barrier control block pointer
+  * \return IRQ_PEND_ERR Can not use barrier create function from interrupt handler code
+  * \return INVALID_PARAMETERS The group has no task
+  * \return NO_AVAILABLE_EVENT No barrier control blocks available
+  * \return ALLOC_EVENT_OK Barrier control block successfully allocated
+  *********************************************************************************************/
+  INT8U OSBarrierCreate (INT8U count, BRTOS_Barrier **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSBarrierDelete (BRTOS_Barrier **event)
+  * \brief Releases a barrier control block
+  * \param **event Address of the barrier control block pointer
+  * \return IRQ_PEND_ERR Can not use barrier delete function from interrupt handler code
+  * \return DELETE_EVENT_OK Barrier control block released with success
+  *********************************************************************************************/
+  INT8U OSBarrierDelete (BRTOS_Barrier **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSBarrierWait (BRTOS_Barrier *pont_event, TickType time_wait)
+  * \brief Waits for the other tasks of the group
+  *  The last task to arrive releases all the waiting tasks at once and starts a new generation.
+  *  A task that times out leaves the group of the current generation.
+  * \param *pont_event Barrier pointer
+  * \param time_wait Timeout to the barrier release - 0 waits forever
+  * \return OK Success
+  * \return TIMEOUT The group was not released in the specified time
+  * \return IRQ_PEND_ERR Can not use barrier wait function from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSBarrierWait (BRTOS_Barrier *pont_event, TickType time_wait);
 #endif
 
 #if (BRTOS_MBOX_EN == 1)
@@ -854,7 +2162,7 @@ void initEvents(void);
   INT8U OSMboxDelete (BRTOS_Mbox **event);
   
   /*****************************************************************************************//**
-  * \fn void *OSMboxPend (BRTOS_Mbox *pont_event, INT16U timeout)
+  * \fn void *OSMboxPend (BRTOS_Mbox *pont_event, TickType timeout)
   * \brief Wait for a message post
   *  Mailbox pend may be used to receive messages from tasks and interrupts.
   *  A task exits a pending state with a mailbox post or by timeout.
@@ -866,7 +2174,7 @@ void initEvents(void);
   * \return TIMEOUT There was no post for this semaphore in the specified time
   * \return IRQ_PEND_ERR Can not use semaphore pend function from interrupt handler code
   *********************************************************************************************/  
-  INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, INT16U timeout);
+  INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, TickType timeout);
   
   /*****************************************************************************************//**
   * \fn INT8U OSMboxPost(BRTOS_Mbox *pont_event, void *message)
@@ -879,6 +2187,21 @@ void initEvents(void);
   * \return ERR_EVENT_NO_CREATED No tasks waiting for the message
   *********************************************************************************************/  
   INT8U OSMboxPost(BRTOS_Mbox *pont_event, void *message);
+
+  #if (BRTOS_POST_WAIT_EN == 1)
+  /*****************************************************************************************//**
+  * \fn INT8U OSMboxPostWait(BRTOS_Mbox *pont_event, void *message, TickType time_wait)
+  * \brief Mailbox post with timeout
+  *  Waits until the previous message is read. OSMboxPost overwrites it instead.
+  * \param *pont_event Mailbox pointer
+  * \param *message Pointer to the message to be sent
+  * \param time_wait Timeout to wait for the message slot. 0 waits forever
+  * \return OK Success
+  * \return TIMEOUT The previous message was not read in the specified time
+  * \return IRQ_PEND_ERR Can not wait from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSMboxPostWait(BRTOS_Mbox *pont_event, void *message, TickType time_wait);
+  #endif
 #endif
 
 
@@ -939,7 +2262,7 @@ void initEvents(void);
   INT8U OSCleanQueue(BRTOS_Queue *pont_event);
   
   /*****************************************************************************************//**
-  * \fn INT8U OSQueuePend (BRTOS_Queue *pont_event, OS_QUEUE *cqueue, INT16U timeout)
+  * \fn INT8U OSQueuePend (BRTOS_Queue *pont_event, OS_QUEUE *cqueue, TickType timeout)
   * \brief Wait for a queue post 
   *  A task exits a pending state with a queue post or by timeout.
   * \param *pont_event Queue event pointer
@@ -947,7 +2270,7 @@ void initEvents(void);
   * \param timeout Timeout to the queue pend exits
   * \return First data in the output buffer of the specified queue
   *********************************************************************************************/
-  INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, INT16U timeout);
+  INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, TickType timeout);
   
   /*****************************************************************************************//**
   * \fn INT8U OSQueuePost(BRTOS_Queue *pont_event, OS_QUEUE *cqueue,INT8U data)
@@ -960,6 +2283,21 @@ void initEvents(void);
   * \return First data in the output buffer of the specified queue
   *********************************************************************************************/
   INT8U OSQueuePost(BRTOS_Queue *pont_event, INT8U data); 
+
+  #if (BRTOS_POST_WAIT_EN == 1)
+  /*****************************************************************************************//**
+  * \fn INT8U OSQueuePostWait(BRTOS_Queue *pont_event, INT8U data, TickType time_wait)
+  * \brief Queue post with timeout
+  *  Waits for space in a full queue. The space is released by a queue pend or clean.
+  * \param *pont_event Queue event pointer
+  * \param data Data to be written in the queue
+  * \param time_wait Timeout to wait for space in the queue. 0 waits forever
+  * \return WRITE_BUFFER_OK Data successfully written
+  * \return TIMEOUT The queue was full for the specified time
+  * \return IRQ_PEND_ERR Can not wait from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSQueuePostWait(BRTOS_Queue *pont_event, INT8U data, TickType time_wait);
+  #endif
 #endif
 
 ////////////////////////////////////////////////////////////
@@ -1119,7 +2457,7 @@ void initEvents(void);
   INT8U OSDQueueClean(BRTOS_Queue *pont_event);
   
   /*****************************************************************************************//**
-  * \fn INT8U OSDQueuePend (BRTOS_Queue *pont_event, void *pdata, INT16U time_wait)
+  * \fn INT8U OSDQueuePend (BRTOS_Queue *pont_event, void *pdata, TickType time_wait)
   * \brief Wait for a queue post 
   *  A task exits a pending state with a queue post or by timeout.
   * \param *pont_event Queue event pointer
@@ -1129,7 +2467,7 @@ void initEvents(void);
   * \return TIMEOUT The queue pend exit by timeout
   * \return READ_BUFFER_OK The queue was successfully read
   *********************************************************************************************/
-  INT8U OSDQueuePend (BRTOS_Queue *pont_event, void *pdata, INT16U time_wait);
+  INT8U OSDQueuePend (BRTOS_Queue *pont_event, void *pdata, TickType time_wait);
   
   /*****************************************************************************************//**
   * \fn INT8U OSDQueuePost(BRTOS_Queue *pont_event, void *pdata)
@@ -1141,6 +2479,468 @@ void initEvents(void);
   * \return
   *********************************************************************************************/
   INT8U OSDQueuePost(BRTOS_Queue *pont_event, void *pdata);
+  
+  /*****************************************************************************************//**
+  * \fn INT8U OSDQueuePostMulti(BRTOS_Queue *pont_event, void *pdata, INT16U count, INT16U *posted)
+  * \brief Posts up to count elements with a single critical section and context switch
+  *  The highest priority waiting task is released, and each reader releases the next waiting
+  *  task while elements are left in the queue. May be used inside interrupt handlers.
+  * \param *pont_event Queue event pointer
+  * \param *pdata Array of elements to be written in the queue
+  * \param count Number of elements in the array
+  * \param *posted Receives the number of posted elements - may be NULL
+  * \return WRITE_BUFFER_OK All the elements were written
+  * \return BUFFER_UNDERRUN Queue overflow - only *posted elements were written
+  * \return ERR_EVENT_NO_CREATED The pont_event is not valid
+  *********************************************************************************************/
+  INT8U OSDQueuePostMulti(BRTOS_Queue *pont_event, void *pdata, INT16U count, INT16U *posted);
+  
+  /*****************************************************************************************//**
+  * \fn INT8U OSDQueuePendMulti(BRTOS_Queue *pont_event, void *pdata, INT16U count, INT16U *received, TickType time_wait)
+  * \brief Reads up to count elements with a single critical section
+  *  If the queue is empty the task waits for the first element. Then all the available
+  *  elements, up to count, are read.
+  * \param *pont_event Queue event pointer
+  * \param *pdata Output array with room for count elements
+  * \param count Maximum number of elements to be read
+  * \param *received Receives the number of read elements - may be NULL
+  * \param time_wait Timeout to the queue pend exits - 0 waits forever
+  * \return READ_BUFFER_OK At least one element was read
+  * \return TIMEOUT The queue pend exit by timeout
+  * \return INVALID_PARAMETERS count is zero
+  * \return ERR_EVENT_NO_CREATED The pont_event is not valid
+  *********************************************************************************************/
+  INT8U OSDQueuePendMulti(BRTOS_Queue *pont_event, void *pdata, INT16U count, INT16U *received, TickType time_wait);
+
+  #if (BRTOS_POST_WAIT_EN == 1)
+  /*****************************************************************************************//**
+  * \fn INT8U OSDQueuePostWait(BRTOS_Queue *pont_event, void *pdata, TickType time_wait)
+  * \brief Dynamic queue post with timeout
+  *  Waits for space in a full queue. The space is released by a queue pend or clean.
+  * \param *pont_event Queue event pointer
+  * \param *pdata Pointer to the element to be copied into the queue
+  * \param time_wait Timeout to wait for space in the queue. 0 waits forever
+  * \return WRITE_BUFFER_OK Data successfully written
+  * \return TIMEOUT The queue was full for the specified time
+  * \return IRQ_PEND_ERR Can not wait from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSDQueuePostWait(BRTOS_Queue *pont_event, void *pdata, TickType time_wait);
+  #endif
+
+  #if (BRTOS_DQUEUE_SLOT_EN == 1)
+  /*****************************************************************************************//**
+  * \fn INT8U OSDQueueReserve(BRTOS_Queue *pont_event, void **slot)
+  * \brief Reserves the next free slot of a dynamic queue
+  *  The element is built in place and published by OSDQueueCommit.
+  *  While the slot is reserved the other posts find the queue full, so a single producer is expected.
+  * \param *pont_event Queue event pointer
+  * \param **slot Returns the reserved slot address
+  * \return WRITE_BUFFER_OK Slot reserved
+  * \return BUFFER_UNDERRUN The queue is full
+  * \return BUSY_RESOURCE There is already a reserved slot
+  *********************************************************************************************/
+  INT8U OSDQueueReserve(BRTOS_Queue *pont_event, void **slot);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSDQueueCommit(BRTOS_Queue *pont_event)
+  * \brief Publishes the slot reserved by OSDQueueReserve
+  * \param *pont_event Queue event pointer
+  * \return WRITE_BUFFER_OK Element published
+  * \return INVALID_PARAMETERS There is no reserved slot
+  *********************************************************************************************/
+  INT8U OSDQueueCommit(BRTOS_Queue *pont_event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSDQueuePeekSlot(BRTOS_Queue *pont_event, void **slot, TickType time_wait)
+  * \brief Removes the first element of a dynamic queue without copying it
+  *  The slot is not reused by the producers until OSDQueueRelease. Only one slot may be peeked.
+  * \param *pont_event Queue event pointer
+  * \param **slot Returns the element address
+  * \param time_wait Timeout to the queue pend exits. 0 waits forever
+  * \return READ_BUFFER_OK Element available
+  * \return TIMEOUT There was no post in the specified time
+  * \return BUSY_RESOURCE There is already a peeked slot
+  *********************************************************************************************/
+  INT8U OSDQueuePeekSlot(BRTOS_Queue *pont_event, void **slot, TickType time_wait);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSDQueueRelease(BRTOS_Queue *pont_event)
+  * \brief Releases the slot returned by OSDQueuePeekSlot
+  * \param *pont_event Queue event pointer
+  * \return READ_BUFFER_OK Slot released
+  * \return INVALID_PARAMETERS There is no peeked slot
+  *********************************************************************************************/
+  INT8U OSDQueueRelease(BRTOS_Queue *pont_event);
+  #endif
+#endif
+
+
+
+#if (BRTOS_MEMPOOL_EN == 1)
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSMemPoolCreate(void *buffer, INT16U block_size, INT16U blocks, BRTOS_MemPool **event)
+  * \brief Allocates a memory pool control block and links the buffer blocks into the free list
+  *  The block size is rounded up to a multiple of the pointer size.
+  *  The buffer must be pointer aligned and hold blocks * (rounded) block_size bytes.
+  * \param *buffer Static buffer of the pool
+  * \param block_size Block size in bytes
+  * \param blocks Number of blocks
+  * \param **event Address of the memory pool control block pointer
+  * \return INVALID_PARAMETERS There is at least one invalid parameter
+  * \return IRQ_PEND_ERR Can not use memory pool create function from interrupt handler code
+  * \return NO_AVAILABLE_EVENT No memory pool control blocks available
+  * \return ALLOC_EVENT_OK Memory pool control block successfully allocated
+  *********************************************************************************************/
+  INT8U OSMemPoolCreate(void *buffer, INT16U block_size, INT16U blocks, BRTOS_MemPool **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSMemPoolDelete (BRTOS_MemPool **event)
+  * \brief Releases a memory pool control block. The buffer is not touched.
+  * \param **event Address of the memory pool control block pointer
+  * \return IRQ_PEND_ERR Can not use memory pool delete function from interrupt handler code
+  * \return DELETE_EVENT_OK Memory pool control block released with success
+  *********************************************************************************************/
+  INT8U OSMemPoolDelete (BRTOS_MemPool **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSMemPoolGet (BRTOS_MemPool *pont_event, void **block, TickType time_wait)
+  * \brief Takes a block from the memory pool
+  *  A task waits for a block release or a timeout when the pool is empty.
+  *  Inside an interrupt handler the function never waits.
+  * \param *pont_event Memory pool pointer
+  * \param **block Receives the block address
+  * \param time_wait Timeout to the wait for a block - 0 waits forever
+  * \return OK Success
+  * \return TIMEOUT No block was released in the specified time
+  * \return NO_AVAILABLE_MEMORY Empty pool inside an interrupt handler
+  * \return ERR_EVENT_NO_CREATED The pont_event is not valid
+  *********************************************************************************************/
+  INT8U OSMemPoolGet (BRTOS_MemPool *pont_event, void **block, TickType time_wait);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSMemPoolPut (BRTOS_MemPool *pont_event, void *block)
+  * \brief Returns a block to the memory pool
+  *  The highest priority waiting task receives the block. May be used inside interrupt handlers.
+  * \param *pont_event Memory pool pointer
+  * \param *block Block address
+  * \return OK Success
+  * \return INVALID_PARAMETERS The block does not belong to this pool
+  * \return ERR_EVENT_NO_CREATED The pont_event is not valid
+  *********************************************************************************************/
+  INT8U OSMemPoolPut (BRTOS_MemPool *pont_event, void *block);
+
+  /*****************************************************************************************//**
+  * \fn void *OSMemPoolTake(INT16U size)
+  * \brief Takes a block from the pool with the smallest block that fits the size (Internal kernel function)
+  *  Must be called inside a critical section. Never waits.
+  * \param size Required size in bytes
+  * \return The block address, or NULL if there is no free block that fits the size
+  *********************************************************************************************/
+  void *OSMemPoolTake(INT16U size);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSMemPoolGive(void *block)
+  * \brief Returns a block taken with OSMemPoolTake (Internal kernel function)
+  *  Must be called inside a critical section. A woken task runs at the next scheduling point.
+  * \param *block Block address
+  * \return OK Success
+  * \return INVALID_PARAMETERS The block does not belong to any pool
+  *********************************************************************************************/
+  INT8U OSMemPoolGive(void *block);
+#endif
+
+
+
+#if (BRTOS_FLAG_EN == 1)
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSFlagCreate (FlagType flags, BRTOS_Flag **event)
+  * \brief Allocates an event flag group control block
+  * \param flags Initial flags
+  * \param **event Address of the event flags control block pointer
+  * \return IRQ_PEND_ERR Can not use event flags create function from interrupt handler code
+  * \return NO_AVAILABLE_EVENT No event flags control blocks available
+  * \return ALLOC_EVENT_OK Event flags control block successfully allocated
+  *********************************************************************************************/
+  INT8U OSFlagCreate (FlagType flags, BRTOS_Flag **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSFlagDelete (BRTOS_Flag **event)
+  * \brief Releases an event flag group control block
+  * \param **event Address of the event flags control block pointer
+  * \return IRQ_PEND_ERR Can not use event flags delete function from interrupt handler code
+  * \return DELETE_EVENT_OK Event flags control block released with success
+  *********************************************************************************************/
+  INT8U OSFlagDelete (BRTOS_Flag **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSFlagPend (BRTOS_Flag *pont_event, FlagType mask, INT8U options, FlagType *flags, TickType time_wait)
+  * \brief Wait for the flags of a group
+  *  A task exits a pending state when the mask condition is satisfied or by timeout.
+  * \param *pont_event Event flags pointer
+  * \param mask Flags to wait for
+  * \param options FLAG_WAIT_ANY or FLAG_WAIT_ALL, optionally combined with FLAG_CLEAR_ON_EXIT
+  * \param *flags Receives the flags of the mask that released the task - may be NULL
+  * \param time_wait Timeout to the event flags pend exits - 0 waits forever
+  * \return OK Success
+  * \return TIMEOUT The condition was not satisfied in the specified time
+  * \return INVALID_PARAMETERS Empty mask
+  * \return IRQ_PEND_ERR Can not use event flags pend function from interrupt handler code
+  * \return ERR_EVENT_NO_CREATED The pont_event is not valid
+  *********************************************************************************************/
+  INT8U OSFlagPend (BRTOS_Flag *pont_event, FlagType mask, INT8U options, FlagType *flags, TickType time_wait);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSFlagSet (BRTOS_Flag *pont_event, FlagType flags)
+  * \brief Sets flags of a group
+  *  All the waiting tasks whose condition is satisfied are released with a single context switch.
+  *  May be used inside interrupt handlers.
+  * \param *pont_event Event flags pointer
+  * \param flags Flags to be set
+  * \return OK Success
+  * \return ERR_EVENT_NO_CREATED The pont_event is not valid
+  *********************************************************************************************/
+  INT8U OSFlagSet (BRTOS_Flag *pont_event, FlagType flags);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSFlagClear (BRTOS_Flag *pont_event, FlagType flags)
+  * \brief Clears flags of a group. May be used inside interrupt handlers.
+  * \param *pont_event Event flags pointer
+  * \param flags Flags to be cleared
+  * \return OK Success
+  * \return ERR_EVENT_NO_CREATED The pont_event is not valid
+  *********************************************************************************************/
+  INT8U OSFlagClear (BRTOS_Flag *pont_event, FlagType flags);
+#endif
+
+
+
+#if (BRTOS_STREAM_EN == 1)
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSStreamCreate(INT8U *buffer, OS_CPU_TYPE size, OS_CPU_TYPE trigger, BRTOS_Stream **event)
+  * \brief Allocates a single producer / single consumer stream buffer control block
+  * \param *buffer Data buffer - holds up to size - 1 bytes
+  * \param size Buffer size in bytes
+  * \param trigger Bytes that release the waiting consumer - from 1 to size - 1
+  * \param **event Address of the stream buffer control block pointer
+  * \return INVALID_PARAMETERS There is at least one invalid parameter
+  * \return IRQ_PEND_ERR Can not use stream buffer create function from interrupt handler code
+  * \return NO_AVAILABLE_EVENT No stream buffer control blocks available
+  * \return ALLOC_EVENT_OK Stream buffer control block successfully allocated
+  *********************************************************************************************/
+  INT8U OSStreamCreate(INT8U *buffer, OS_CPU_TYPE size, OS_CPU_TYPE trigger, BRTOS_Stream **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSStreamDelete (BRTOS_Stream **event)
+  * \brief Releases a stream buffer control block
+  * \param **event Address of the stream buffer control block pointer
+  * \return IRQ_PEND_ERR Can not use stream buffer delete function from interrupt handler code
+  * \return DELETE_EVENT_OK Stream buffer control block released with success
+  *********************************************************************************************/
+  INT8U OSStreamDelete (BRTOS_Stream **event);
+
+  /*****************************************************************************************//**
+  * \fn OS_CPU_TYPE OSStreamSend(BRTOS_Stream *pont_event, const INT8U *data, OS_CPU_TYPE length)
+  * \brief Writes data into the stream buffer (single producer - task or interrupt handler)
+  *  Interrupts are not disabled to copy the data. A critical section is only used
+  *  to release the consumer when it is waiting and the trigger level is reached.
+  * \param *pont_event Stream buffer pointer
+  * \param *data Data to be written
+  * \param length Number of bytes
+  * \return Number of bytes written - less than length if the buffer is full
+  *********************************************************************************************/
+  OS_CPU_TYPE OSStreamSend(BRTOS_Stream *pont_event, const INT8U *data, OS_CPU_TYPE length);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSStreamReceive(BRTOS_Stream *pont_event, INT8U *data, OS_CPU_TYPE length, OS_CPU_TYPE *received, TickType time_wait)
+  * \brief Reads data from the stream buffer (single consumer)
+  *  The task waits until the trigger level (or length, if smaller) is available or the timeout.
+  *  Then all the available data, up to length, is read. Never waits inside an interrupt handler
+  *  or while the scheduler is locked.
+  * \param *pont_event Stream buffer pointer
+  * \param *data Output buffer
+  * \param length Output buffer size in bytes
+  * \param *received Receives the number of bytes read - may be NULL
+  * \param time_wait Timeout to the stream wait exits - 0 waits forever
+  * \return OK At least one byte was read
+  * \return TIMEOUT No data was available
+  * \return ERR_EVENT_NO_CREATED The pont_event is not valid
+  *********************************************************************************************/
+  INT8U OSStreamReceive(BRTOS_Stream *pont_event, INT8U *data, OS_CPU_TYPE length, OS_CPU_TYPE *received, TickType time_wait);
+#endif
+
+
+
+#if (BRTOS_SET_EN == 1)
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSSetCreate (BRTOS_Set **event)
+  * \brief Allocates an event set control block
+  * \param **event Address of the event set control block pointer
+  * \return IRQ_PEND_ERR Can not use event set create function from interrupt handler code
+  * \return NO_AVAILABLE_EVENT No event set control blocks available
+  * \return ALLOC_EVENT_OK Event set control block successfully allocated
+  *********************************************************************************************/
+  INT8U OSSetCreate (BRTOS_Set **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSSetDelete (BRTOS_Set **event)
+  * \brief Releases an event set control block. The members leave the set.
+  * \param **event Address of the event set control block pointer
+  * \return IRQ_PEND_ERR Can not use event set delete function from interrupt handler code
+  * \return DELETE_EVENT_OK Event set control block released with success
+  *********************************************************************************************/
+  INT8U OSSetDelete (BRTOS_Set **event);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSSetAdd (BRTOS_Set *pont_event, void *member, INT8U type)
+  * \brief Adds a semaphore, mailbox or queue to an event set
+  *  An object belongs to only one set. Remove it from the set before deleting it.
+  * \param *pont_event Event set pointer
+  * \param *member Semaphore, mailbox or queue control block pointer
+  * \param type SET_SEM, SET_MBOX, SET_QUEUE or SET_DQUEUE
+  * \return OK Success
+  * \return INVALID_PARAMETERS Invalid type or the object is already in a set
+  * \return NO_AVAILABLE_MEMORY The set already has BRTOS_SET_MEMBERS members
+  *********************************************************************************************/
+  INT8U OSSetAdd (BRTOS_Set *pont_event, void *member, INT8U type);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSSetRemove (BRTOS_Set *pont_event, void *member)
+  * \brief Removes an object from an event set
+  * \param *pont_event Event set pointer
+  * \param *member Semaphore, mailbox or queue control block pointer
+  * \return OK Success
+  * \return INVALID_PARAMETERS The object is not in the set
+  *********************************************************************************************/
+  INT8U OSSetRemove (BRTOS_Set *pont_event, void *member);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSSetPend (BRTOS_Set *pont_event, void **member, TickType time_wait)
+  * \brief Waits until one of the set members has data
+  *  The data is not taken. The caller uses the member pend function, that returns at once
+  *  unless a higher priority task took the data first. If the posted member is removed
+  *  from the set before the task runs, the task waits again until the same timeout.
+  * \param *pont_event Event set pointer
+  * \param **member Returns the ready member control block pointer
+  * \param time_wait Timeout to the event set pend exits - 0 waits forever
+  * \return OK Success
+  * \return TIMEOUT No member was posted in the specified time
+  * \return IRQ_PEND_ERR Can not use event set pend function from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSSetPend (BRTOS_Set *pont_event, void **member, TickType time_wait);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSSetSignal(BRTOS_Set *pont_event, void *member)
+  * \brief Releases a task waiting for the set (Internal kernel function)
+  *  Called by the member post functions, inside a critical section.
+  * \param *pont_event Event set pointer - may be NULL
+  * \param *member Posted member
+  * \return TRUE if a task was released
+  *********************************************************************************************/
+  INT8U OSSetSignal(BRTOS_Set *pont_event, void *member);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSSetUnlink(BRTOS_Set *pont_event, void *member)
+  * \brief Removes a member from its set (Internal kernel function)
+  *  Called by OSSetRemove and by the member delete functions, inside a critical section.
+  * \param *pont_event Event set pointer
+  * \param *member Member control block
+  * \return FALSE if the member does not belong to the set
+  *********************************************************************************************/
+  INT8U OSSetUnlink(BRTOS_Set *pont_event, void *member);
+#endif
+
+
+
+#if (BRTOS_DEFER_EN == 1)
+
+  /// Deferred function type
+  typedef void (*FCN_DEFERRED)(void *arg);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSDeferInit(INT16U stacksize, INT8U prio)
+  * \brief Installs the deferred call task
+  *  Must be called before the scheduler starts. The task priority is usually above the
+  *  priorities of the tasks that use the deferred work.
+  * \param stacksize Size of the task stack
+  * \param prio Task priority
+  * \return OK Success
+  * \return The InstallTask error code if the task could not be installed
+  *********************************************************************************************/
+  INT8U OSDeferInit(INT16U stacksize, INT8U prio);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSDeferCall(FCN_DEFERRED func, void *arg)
+  * \brief Defers a function call to the deferred call task
+  *  Used by interrupt handlers to move the work out of the interrupt. The calls run in
+  *  the order they were made. Nothing is allocated - the call is copied into a ring buffer
+  *  of BRTOS_DEFER_SIZE entries.
+  * \param func Function to be called
+  * \param arg Function argument
+  * \return OK Success
+  * \return BUFFER_UNDERRUN The ring buffer is full and the call was not deferred
+  *********************************************************************************************/
+  INT8U OSDeferCall(FCN_DEFERRED func, void *arg);
+#endif
+
+
+
+#if ((BRTOS_WORK_EN == 1) && (BRTOS_SEM_EN == 1) && (BRTOS_DYNAMIC_QUEUE_ENABLED == 1))
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSWorkInit(const INT8U *priorities, INT8U workers, INT16U stacksize)
+  * \brief Creates the job queue and installs the worker tasks
+  *  Must be called once, before the scheduler starts.
+  * \param *priorities Priorities of the worker tasks - one for each worker
+  * \param workers Number of worker tasks
+  * \param stacksize Size of the stack of each worker task
+  * \return OK Success
+  * \return INVALID_PARAMETERS There is at least one invalid parameter
+  * \return The queue, semaphore or InstallTask error code if the pool could not be created
+  *********************************************************************************************/
+  INT8U OSWorkInit(const INT8U *priorities, INT8U workers, INT16U stacksize);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSWorkSubmit(FCN_WORK func, void *arg, TickType time_wait, BRTOS_Work **work)
+  * \brief Submits a job to the worker tasks
+  *  The jobs run in submission order. The caller waits while the BRTOS_WORK_QUEUE_SIZE
+  *  job entries are in use.
+  * \param func Job function
+  * \param arg Job function argument
+  * \param time_wait Timeout to a free job entry - 0 waits forever
+  * \param **work Receives the job handle, valid until the job starts - may be NULL
+  * \return OK Success
+  * \return TIMEOUT There was no free job entry in the specified time
+  * \return IRQ_PEND_ERR Can not use work submit function from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSWorkSubmit(FCN_WORK func, void *arg, TickType time_wait, BRTOS_Work **work);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSWorkSubmitDelayed(FCN_WORK func, void *arg, TickType delay, TickType time_wait, BRTOS_Work **work)
+  * \brief Submits a job that waits for a delay before it is given to the worker tasks
+  *  The delayed job uses a job entry while it waits.
+  * \param func Job function
+  * \param arg Job function argument
+  * \param delay Delay in ticks - 0 submits the job at once
+  * \param time_wait Timeout to a free job entry - 0 waits forever
+  * \param **work Receives the job handle, valid until the job starts - may be NULL
+  * \return OK Success
+  * \return TIMEOUT There was no free job entry in the specified time
+  * \return IRQ_PEND_ERR Can not use work submit function from interrupt handler code
+  *********************************************************************************************/
+  INT8U OSWorkSubmitDelayed(FCN_WORK func, void *arg, TickType delay, TickType time_wait, BRTOS_Work **work);
+
+  /*****************************************************************************************//**
+  * \fn INT8U OSWorkCancel(BRTOS_Work *work)
+  * \brief Cancels a job that has not started
+  * \param *work Job handle returned by the submit function
+  * \return OK The job will not run
+  * \return BUSY_RESOURCE The job is running, has already run or was cancelled
+  *********************************************************************************************/
+  INT8U OSWorkCancel(BRTOS_Work *work);
 #endif
 
 ////////////////////////////////////////////////////////////
@@ -1160,12 +2960,21 @@ void initEvents(void);
 
 extern       PriorityType OSReadyList;
 extern       PriorityType OSBlockedList;
-extern const PriorityType PriorityMask[configMAX_TASK_PRIORITY+1];
+extern const PriorityBits PriorityMask[PRIORITY_BITS];
 
 extern ContextType *Tail;
 extern ContextType *Head;
 
 extern INT8U                iNesting;
+#if (BRTOS_SCHED_LOCK_EN == 1)
+extern volatile INT8U       OSSchedLockNesting;
+#endif
+#if (BRTOS_MUTEX_EN == 1) && (BRTOS_MUTEX_INHERIT_EN == 1)
+extern volatile INT8U       OSMutexInheritPending;
+#endif
+#if (BRTOS_RWLOCK_EN == 1)
+extern volatile INT8U       OSRWLockBoostPending;
+#endif
 extern volatile INT8U       currentTask;
 extern volatile INT8U       SelectedTask;
 extern ContextType          ContextTask[NUMBER_OF_TASKS + 2];
@@ -1188,7 +2997,7 @@ extern volatile INT32U      OSDutyTmp;
 	#error("You must define the OS_CPU_TYPE !!!")
 #endif
 
-extern INT32U TaskAlloc;
+extern INT32U TaskAlloc[TASK_ALLOC_WORDS];
 extern INT16U iQueueAddress;
 
 #if (PROCESSOR == ATMEGA)
@@ -1274,21 +3083,7 @@ extern CHAR8 BufferText[32];
 
 
 #define IncludeTaskIntoDelayList()                  \
-        if(Tail != NULL)                            \
-        {                                           \
-          /* Insert task into list */               \
-          Tail->Next = Task;                        \
-          Task->Previous = Tail;                    \
-          Tail = Task;                              \
-          Tail->Next = NULL;                        \
-        }                                           \
-        else{                                       \
-           /* Init delay list */                    \
-           Tail = Task;                             \
-           Head = Task;                             \
-           Task->Next = NULL;                       \
-           Task->Previous = NULL;                   \
-        }
+        OSDelayListInsert(Task)
 
 
 #endif
@@ -72,6 +72,62 @@
 
 
 #if (BRTOS_MBOX_EN == 1)
+
+#if (BRTOS_POST_WAIT_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Mailbox Send Wait Internal Function         /////
+/////                                                  /////
+/////  Must be called inside a critical section        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Releases the highest priority task waiting for the message slot
+// The released task keeps the slot until it runs
+static INT8U OSMboxSendWakeup(BRTOS_Mbox *pont_event)
+{
+  INT8U iPriority;
+  INT8U TaskSelect = 0;
+  
+  if (pont_event->OSEventSendWait == 0)
+  {
+    return FALSE;
+  }
+  
+  // Selects the highest priority task
+  iPriority = PrioListHighest(pont_event->OSEventSendWaitList);
+  TaskSelect = OSWaitListTask(pont_event->OSEventSendWaitList, iPriority);
+  
+  // Remove the selected task from the mailbox send wait list
+  OSWaitListRemove(pont_event->OSEventSendWaitList, TaskSelect, iPriority);
+  
+  // Decreases the mailbox send wait list counter
+  pont_event->OSEventSendWait--;
+  
+  // Keeps the slot to the selected task
+  pont_event->OSEventSendReserved = TRUE;
+  #if (TASK_RESERVATION_EN == 1)
+  ContextTask[TaskSelect].Reservation = pont_event;
+  #endif
+  
+  // Put the selected task into Ready List
+  #if (VERBOSE == 1)
+  ContextTask[TaskSelect].State = READY;
+  #endif
+  
+  OSReadyListAdd(TaskSelect, iPriority);
+  
+  return TRUE;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
+
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 /////      Create MailBox Function                     /////
@@ -81,7 +137,9 @@
 INT8U OSMboxCreate (BRTOS_Mbox **event, void *message)
 {
   OS_SR_SAVE_VAR
-  INT16S i = 0;  
+  #if (BRTOS_OBJECT_POOL_EN == 0)
+  INT16S i = 0;
+  #endif
   BRTOS_Mbox *pont_event;
 
   if (iNesting > 0) {                                // See if caller is an interrupt
@@ -92,6 +150,18 @@ INT8U OSMboxCreate (BRTOS_Mbox **event, void *message)
   if (currentTask)
      OSEnterCritical();
   
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Takes a control block from the shared object pool
+  pont_event = (BRTOS_Mbox*)OSObjectAlloc(OBJECT_MBOX);
+  if (pont_event == NULL)
+  {
+    // Exit critical Section
+    if (currentTask)
+       OSExitCritical();
+
+    return(NO_AVAILABLE_EVENT);
+  }
+  #else
   // Verifica se ainda h blocos de controle de eventos disponveis
   for(i=0;i<=BRTOS_MAX_MBOX;i++)
   {
@@ -115,6 +185,7 @@ INT8U OSMboxCreate (BRTOS_Mbox **event, void *message)
       break;      
     }
   }    
+  #endif
     
   if (message != NULL)
   {
@@ -127,7 +198,15 @@ INT8U OSMboxCreate (BRTOS_Mbox **event, void *message)
   
   pont_event->OSEventPointer   = message;
   pont_event->OSEventWait      = 0;  
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
+  #if (BRTOS_SET_EN == 1)
+  pont_event->OSEventSet = NULL;
+  #endif
+  #if (BRTOS_POST_WAIT_EN == 1)
+  pont_event->OSEventSendWait     = 0;
+  pont_event->OSEventSendReserved = FALSE;
+  PrioListInit(pont_event->OSEventSendWaitList);
+  #endif
   
   
   *event = pont_event;
@@ -167,12 +246,39 @@ INT8U OSMboxDelete (BRTOS_Mbox **event)
   OSEnterCritical();
   
   pont_event = *event;
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_MBOX))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  #if (BRTOS_SET_EN == 1)
+  // The object leaves its event set before the control block is released
+  if (pont_event->OSEventSet != NULL)
+  {
+    (void)OSSetUnlink(pont_event->OSEventSet, pont_event);
+  }
+  #endif
   pont_event->OSEventAllocated   = 0;
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Gives the control block back to the shared object pool
+  OSObjectFree(pont_event);
+  #endif
   pont_event->OSEventPointer     = NULL;
   pont_event->OSEventWait        = 0;
   pont_event->OSEventState       = NO_MESSAGE;
   
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
+  #if (BRTOS_POST_WAIT_EN == 1)
+  pont_event->OSEventSendWait     = 0;
+  pont_event->OSEventSendReserved = FALSE;
+  PrioListInit(pont_event->OSEventSendWaitList);
+  #endif
   
   *event = NULL;
   
@@ -197,11 +303,10 @@ INT8U OSMboxDelete (BRTOS_Mbox **event)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, INT16U time_wait)
+INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, TickType time_wait)
 {
   OS_SR_SAVE_VAR
   INT8U  iPriority = 0;
-  INT32U  timeout;
   ContextType *Task;  
   
   #if (ERROR_CHECK == 1)
@@ -219,13 +324,21 @@ INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, INT16U time_wait)
       return(NULL_EVENT_POINTER);
     }
   #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
     
   // Enter Critical Section
   OSEnterCritical();
 
   #if (ERROR_CHECK == 1)
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_MBOX))
     {
       // Exit Critical Section
       OSExitCritical();
@@ -242,6 +355,14 @@ INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, INT16U time_wait)
     // Free message slot
     pont_event->OSEventState = NO_MESSAGE;
     
+    #if (BRTOS_POST_WAIT_EN == 1)
+    // Release a task waiting for the message slot
+    if (OSMboxSendWakeup(pont_event))
+    {
+      ChangeContext();
+    }
+    #endif
+    
     // Exit Critical Section
     OSExitCritical();
     return OK;
@@ -257,7 +378,7 @@ INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, INT16U time_wait)
     pont_event->OSEventWait++;
     
     // Allocates the current task on the mailbox wait list
-    pont_event->OSEventWaitList = pont_event->OSEventWaitList | (PriorityMask[iPriority]);
+    OSWaitListAdd(pont_event->OSEventWaitList, currentTask, iPriority);
     
     // Task entered suspended state, waiting for mailbox post
     #if (VERBOSE == 1)
@@ -266,21 +387,12 @@ INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, INT16U time_wait)
     #endif
     
     // Remove current task from the Ready List
-    OSReadyList = OSReadyList & ~(PriorityMask[iPriority]);
+    OSReadyListRemove(currentTask, iPriority);
 
     // Set timeout overflow
     if (time_wait)
     {  
-      timeout = (INT32U)((INT32U)OSGetCount() + (INT32U)time_wait);
-      
-      if (timeout >= TICK_COUNT_OVERFLOW)
-      {
-        Task->TimeToWait = (INT16U)(timeout - TICK_COUNT_OVERFLOW);
-      }
-      else
-      {
-        Task->TimeToWait = (INT16U)timeout;
-      }
+      Task->TimeToWait = OSWakeTimeCompute(time_wait);
       
       // Put task into delay list
       IncludeTaskIntoDelayList();
@@ -303,10 +415,10 @@ INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, INT16U time_wait)
         if(Task->TimeToWait == EXIT_BY_TIMEOUT)
         {
             // Test if both timeout and post have occured before arrive here
-            if ((pont_event->OSEventWaitList & PriorityMask[iPriority]))
+            if (OSWaitListTest(pont_event->OSEventWaitList, currentTask, iPriority))
             {
               // Remove the task from the queue wait list
-              pont_event->OSEventWaitList = pont_event->OSEventWaitList & ~(PriorityMask[iPriority]);
+              OSWaitListRemove(pont_event->OSEventWaitList, currentTask, iPriority);
               
               // Decreases the queue wait list counter
               pont_event->OSEventWait--;
@@ -338,6 +450,14 @@ INT8U OSMboxPend (BRTOS_Mbox *pont_event, void **Mail, INT16U time_wait)
     // Free message slot
     pont_event->OSEventState = NO_MESSAGE;
     
+    #if (BRTOS_POST_WAIT_EN == 1)
+    // Release a task waiting for the message slot
+    if (OSMboxSendWakeup(pont_event))
+    {
+      ChangeContext();
+    }
+    #endif
+    
     // Exit Critical Section
     OSExitCritical();  
     return OK;    
@@ -363,9 +483,7 @@ INT8U OSMboxPost(BRTOS_Mbox *pont_event, void *message)
 {
   OS_SR_SAVE_VAR
   INT8U iPriority = (INT8U)0;
-  #if (VERBOSE == 1)
   INT8U TaskSelect = 0;  
-  #endif
   
   #if (ERROR_CHECK == 1)    
     // Verifies if the pointer is NULL
@@ -383,7 +501,7 @@ INT8U OSMboxPost(BRTOS_Mbox *pont_event, void *message)
      
   #if (ERROR_CHECK == 1)        
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_MBOX))
     {
       // Exit Critical Section
       #if (NESTING_INT == 0)
@@ -398,21 +516,21 @@ INT8U OSMboxPost(BRTOS_Mbox *pont_event, void *message)
   if (pont_event->OSEventWait != 0)
   {
     // Selects the highest priority task
-    iPriority = SAScheduler(pont_event->OSEventWaitList);
+    iPriority = PrioListHighest(pont_event->OSEventWaitList);
+    TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
 
     // Remove the selected task from the mailbox wait list
-    pont_event->OSEventWaitList = pont_event->OSEventWaitList & ~(PriorityMask[iPriority]);
+    OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
     
     // Decreases the mailbox wait list counter
     pont_event->OSEventWait--;
     
     // Put the selected task into Ready List
     #if (VERBOSE == 1)
-    TaskSelect = PriorityVector[iPriority];
     ContextTask[TaskSelect].State = READY;
     #endif
     
-    OSReadyList = OSReadyList | (PriorityMask[iPriority]);
+    OSReadyListAdd(TaskSelect, iPriority);
     
     // Copy message pointer
     pont_event->OSEventPointer = message;
@@ -443,6 +561,14 @@ INT8U OSMboxPost(BRTOS_Mbox *pont_event, void *message)
     
     // Free message slot
     pont_event->OSEventState = AVAILABLE_MESSAGE;
+    
+    #if (BRTOS_SET_EN == 1)
+    // Signals the set that holds this mailbox
+    if (OSSetSignal(pont_event->OSEventSet, pont_event) && !iNesting)
+    {
+      ChangeContext();
+    }
+    #endif
       
   // Exit Critical Section
   #if (NESTING_INT == 0)
@@ -458,4 +584,190 @@ INT8U OSMboxPost(BRTOS_Mbox *pont_event, void *message)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
+
+
+
+
+#if (BRTOS_POST_WAIT_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Mailbox Post With Timeout Function          /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSMboxPostWait(BRTOS_Mbox *pont_event, void *message, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U iPriority = (INT8U)0;
+  INT8U TaskSelect = 0;
+  ContextType *Task;
+  
+  #if (ERROR_CHECK == 1)
+    /// Can not wait for the message slot from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+    
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+  
+  // Enter Critical Section
+  OSEnterCritical();
+  
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_MBOX))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+  
+  // Verify if the message slot is busy or kept to a released task
+  if ((pont_event->OSEventState == AVAILABLE_MESSAGE) || (pont_event->OSEventSendReserved == TRUE))
+  {
+    Task = (ContextType*)&ContextTask[currentTask];
+    
+    // Copy task priority to local scope
+    iPriority = Task->Priority;
+    
+    // Increases the mailbox send wait list counter
+    pont_event->OSEventSendWait++;
+    
+    // Allocates the current task on the mailbox send wait list
+    OSWaitListAdd(pont_event->OSEventSendWaitList, currentTask, iPriority);
+    
+    // Task entered suspended state, waiting for the message slot
+    #if (VERBOSE == 1)
+    Task->State = SUSPENDED;
+    Task->SuspendedType = MAILBOX;
+    #endif
+    
+    // Remove current task from the Ready List
+    OSReadyListRemove(currentTask, iPriority);
+    
+    // Set timeout overflow
+    if (time_wait)
+    {  
+      Task->TimeToWait = OSWakeTimeCompute(time_wait);
+      
+      // Put task into delay list
+      IncludeTaskIntoDelayList();
+    } else
+    {
+      Task->TimeToWait = NO_TIMEOUT;
+    }
+    
+    // Change Context - Returns on time overflow or mailbox pend
+    ChangeContext();
+    
+    // Exit Critical Section
+    OSExitCritical();
+    // Enter Critical Section
+    OSEnterCritical();
+    
+    if (time_wait)
+    {    
+        // Verify if the reason of task wake up was timeout
+        if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+        {
+            // Test if both timeout and pend have occured before arrive here
+            if (OSWaitListTest(pont_event->OSEventSendWaitList, currentTask, iPriority))
+            {
+              // Remove the task from the mailbox send wait list
+              OSWaitListRemove(pont_event->OSEventSendWaitList, currentTask, iPriority);
+              
+              // Decreases the mailbox send wait list counter
+              pont_event->OSEventSendWait--;
+              
+              // Exit Critical Section
+              OSExitCritical();
+              
+              // Indicates mailbox timeout
+              return TIMEOUT;
+            }
+        }
+        else
+        {
+            // Remove the time to wait condition
+            Task->TimeToWait = NO_TIMEOUT;
+            
+            // Remove from delay list
+            RemoveFromDelayList();
+        }
+    }
+    
+    // Takes the slot kept by the pend function
+    pont_event->OSEventSendReserved = FALSE;
+    #if (TASK_RESERVATION_EN == 1)
+    Task->Reservation = NULL;
+    #endif
+  }
+  
+  // Copy message pointer
+  pont_event->OSEventPointer = message;
+  
+  // Fill message slot
+  pont_event->OSEventState = AVAILABLE_MESSAGE;
+  
+  // See if any task is waiting for a message
+  if (pont_event->OSEventWait != 0)
+  {
+    // Selects the highest priority task
+    iPriority = PrioListHighest(pont_event->OSEventWaitList);
+    TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
+
+    // Remove the selected task from the mailbox wait list
+    OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
+    
+    // Decreases the mailbox wait list counter
+    pont_event->OSEventWait--;
+    
+    // Put the selected task into Ready List
+    #if (VERBOSE == 1)
+    ContextTask[TaskSelect].State = READY;
+    #endif
+    
+    OSReadyListAdd(TaskSelect, iPriority);
+    
+    // Verify if there is a higher priority task ready to run
+    ChangeContext();
+  }
+  #if (BRTOS_SET_EN == 1)
+  else
+  {
+    // Signals the set that holds this mailbox
+    if (OSSetSignal(pont_event->OSEventSet, pont_event))
+    {
+      ChangeContext();
+    }
+  }
+  #endif
+  
+  // Exit Critical Section
+  OSExitCritical();
+  
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
 #endif
@@ -0,0 +1,564 @@
+/**
+* \file mempool.c
+* \brief BRTOS Memory Pool functions
+*
+* Functions to install and use fixed-block memory pools
+*
+**/
+/*********************************************************************************************************
+*                                               BRTOS
+*                                Brazilian Real-Time Operating System
+*                            Acronymous of Basic Real-Time Operating System
+*
+*
+*                                  Open Source RTOS under MIT License
+*
+*
+*
+*                                      OS Memory Pool functions
+*
+*
+*   Revision: 1.80
+*   Date:     17/10/2026
+*
+*********************************************************************************************************/
+
+#include "BRTOS.h"
+
+#if (PROCESSOR == COLDFIRE_V1)
+#pragma warn_implicitconv off
+#endif
+
+#if (BRTOS_MEMPOOL_EN == 1)
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Memory Pool Internal Functions              /////
+/////                                                  /////
+/////  Must be called inside a critical section        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Removes the first block of the free list
+static void *OSMemPoolPop(BRTOS_MemPool *pont_event)
+{
+  void *block = pont_event->OSMemFreeList;
+
+  // The first word of a free block points to the next free block
+  pont_event->OSMemFreeList = *(void**)block;
+  pont_event->OSMemFree--;
+
+  return block;
+}
+
+
+// Returns a block to the free list and wakes up the highest priority waiting task
+// Returns TRUE if a task was woken up
+static INT8U OSMemPoolPush(BRTOS_MemPool *pont_event, void *block)
+{
+  INT8U iPriority = (INT8U)0;
+  INT8U TaskSelect = 0;
+
+  *(void**)block = pont_event->OSMemFreeList;
+  pont_event->OSMemFreeList = block;
+  pont_event->OSMemFree++;
+
+  // See if any task is waiting for a block
+  if (pont_event->OSEventWait != 0)
+  {
+    // Selects the highest priority task
+    iPriority = PrioListHighest(pont_event->OSEventWaitList);
+    TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
+
+    // Remove the selected task from the pool wait list
+    OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
+
+    // Decreases the pool wait list counter
+    pont_event->OSEventWait--;
+
+    // The block is kept for the selected task
+    pont_event->OSMemReserved++;
+    #if (TASK_RESERVATION_EN == 1)
+    ContextTask[TaskSelect].Reservation = pont_event;
+    #endif
+
+    // Put the selected task into Ready List
+    #if (VERBOSE == 1)
+    ContextTask[TaskSelect].State = READY;
+    #endif
+
+    OSReadyListAdd(TaskSelect, iPriority);
+
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+
+// Finds the pool that owns the block
+static BRTOS_MemPool *OSMemPoolOwner(void *block)
+{
+  INT8U i = 0;
+
+  for(i=0;i<BRTOS_MAX_MEMPOOL;i++)
+  {
+    if ((BRTOS_MemPool_Table[i].OSEventAllocated == TRUE) &&
+        ((INT8U*)block >= BRTOS_MemPool_Table[i].OSMemStart) &&
+        ((INT8U*)block < BRTOS_MemPool_Table[i].OSMemEnd))
+    {
+      return &BRTOS_MemPool_Table[i];
+    }
+  }
+
+  return NULL;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Create Memory Pool Function                 /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSMemPoolCreate(void *buffer, INT16U block_size, INT16U blocks, BRTOS_MemPool **event)
+{
+  OS_SR_SAVE_VAR
+  INT16U i = 0;
+  INT8U  *block;
+  BRTOS_MemPool *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be create by interrupt
+  }
+
+  if ((buffer == NULL) || (block_size == 0) || (blocks == 0))
+  {
+     return(INVALID_PARAMETERS);
+  }
+
+  // Each free block stores the free list link, so the block size
+  // is rounded up to a multiple of the pointer size
+  block_size = (INT16U)((block_size + sizeof(void*) - 1) & ~(sizeof(void*) - 1));
+
+  // Enter critical Section
+  if (currentTask)
+     OSEnterCritical();
+
+  // Verifies if there is available event control block
+  for(i=0;i<=BRTOS_MAX_MEMPOOL;i++)
+  {
+
+    if(i >= BRTOS_MAX_MEMPOOL)
+    {
+      // Exit critical Section
+      if (currentTask)
+         OSExitCritical();
+
+      return(NO_AVAILABLE_EVENT);
+    }
+
+    if(BRTOS_MemPool_Table[i].OSEventAllocated != TRUE)
+    {
+      BRTOS_MemPool_Table[i].OSEventAllocated = TRUE;
+      pont_event = &BRTOS_MemPool_Table[i];
+      break;
+    }
+  }
+
+  // Link all the blocks into the free list
+  block = (INT8U*)buffer;
+  for(i=0;i<(blocks - 1);i++)
+  {
+    *(void**)block = (void*)(block + block_size);
+    block += block_size;
+  }
+  *(void**)block = NULL;
+
+  pont_event->OSMemStart     = (INT8U*)buffer;
+  pont_event->OSMemEnd       = block + block_size;
+  pont_event->OSMemFreeList  = buffer;
+  pont_event->OSMemBlockSize = block_size;
+  pont_event->OSMemFree      = blocks;
+  pont_event->OSMemReserved  = 0;
+  pont_event->OSEventWait    = 0;
+
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = pont_event;
+
+  // Exit critical Section
+  if (currentTask)
+     OSExitCritical();
+
+  return(ALLOC_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Delete Memory Pool Function                 /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSMemPoolDelete (BRTOS_MemPool **event)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_MemPool *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be delete by interrupt
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  pont_event = *event;
+  pont_event->OSEventAllocated = 0;
+  pont_event->OSEventWait      = 0;
+  pont_event->OSMemFreeList    = NULL;
+  pont_event->OSMemFree        = 0;
+  pont_event->OSMemReserved    = 0;
+
+  PrioListInit(pont_event->OSEventWaitList);
+
+  *event = NULL;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return(DELETE_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Memory Pool Get Function                    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSMemPoolGet (BRTOS_MemPool *pont_event, void **block, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U  iPriority = 0;
+  ContextType *Task;
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the pointer is NULL
+    if((pont_event == NULL) || (block == NULL))
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // Verify if there is a block that is not kept for a woken task
+  if (pont_event->OSMemFree > pont_event->OSMemReserved)
+  {
+    *block = OSMemPoolPop(pont_event);
+
+    // Exit Critical Section
+    #if (NESTING_INT == 0)
+    if (!iNesting)
+    #endif
+       OSExitCritical();
+    return OK;
+  }
+
+  // An interrupt handler can not wait for a block
+  if (iNesting)
+  {
+    *block = NULL;
+
+    // Exit Critical Section
+    #if (NESTING_INT == 0)
+    if (!iNesting)
+    #endif
+       OSExitCritical();
+    return(NO_AVAILABLE_MEMORY);
+  }
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+  // Can not wait while the scheduler is locked
+  if (OSSchedLockNesting)
+  {
+    *block = NULL;
+
+    // Exit Critical Section
+    OSExitCritical();
+    return(SCHED_LOCK_PEND_ERR);
+  }
+  #endif
+
+  Task = (ContextType*)&ContextTask[currentTask];
+
+  // Copy task priority to local scope
+  iPriority = Task->Priority;
+  // Increases the pool wait list counter
+  pont_event->OSEventWait++;
+
+  // Allocates the current task on the pool wait list
+  OSWaitListAdd(pont_event->OSEventWaitList, currentTask, iPriority);
+
+  // Task entered suspended state, waiting for a block
+  #if (VERBOSE == 1)
+  Task->State = SUSPENDED;
+  Task->SuspendedType = MEMPOOL;
+  #endif
+
+  // Remove current task from the Ready List
+  OSReadyListRemove(currentTask, iPriority);
+
+  // Set timeout overflow
+  if (time_wait)
+  {
+    Task->TimeToWait = OSWakeTimeCompute(time_wait);
+
+    // Put task into delay list
+    IncludeTaskIntoDelayList();
+  } else
+  {
+    Task->TimeToWait = NO_TIMEOUT;
+  }
+
+  // Change Context - Returns on time overflow or block release
+  ChangeContext();
+
+  // Exit Critical Section
+  OSExitCritical();
+  // Enter Critical Section
+  OSEnterCritical();
+
+  if (time_wait)
+  {
+      // Verify if the reason of task wake up was pool timeout
+      if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+      {
+          // Test if both timeout and release have occured before arrive here
+          if (OSWaitListTest(pont_event->OSEventWaitList, currentTask, iPriority))
+          {
+            // Remove the task from the pool wait list
+            OSWaitListRemove(pont_event->OSEventWaitList, currentTask, iPriority);
+
+            // Decreases the pool wait list counter
+            pont_event->OSEventWait--;
+
+            // Exit Critical Section
+            OSExitCritical();
+
+            *block = NULL;
+
+            // Indicates pool timeout
+            return TIMEOUT;
+          }
+      }
+      else
+      {
+          // Remove the time to wait condition
+          Task->TimeToWait = NO_TIMEOUT;
+
+          // Remove from delay list
+          RemoveFromDelayList();
+      }
+  }
+
+  // Takes the block kept by the release
+  pont_event->OSMemReserved--;
+  #if (TASK_RESERVATION_EN == 1)
+  Task->Reservation = NULL;
+  #endif
+  *block = OSMemPoolPop(pont_event);
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Memory Pool Put Function                    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSMemPoolPut (BRTOS_MemPool *pont_event, void *block)
+{
+  OS_SR_SAVE_VAR
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+
+    // Verifies if the block belongs to this pool
+    if(((INT8U*)block < pont_event->OSMemStart) || ((INT8U*)block >= pont_event->OSMemEnd) ||
+       ((INT16U)((INT8U*)block - pont_event->OSMemStart) % pont_event->OSMemBlockSize))
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(INVALID_PARAMETERS);
+    }
+  #endif
+
+  if (OSMemPoolPush(pont_event, block) == TRUE)
+  {
+    // If outside of an interrupt service routine, change context to the highest priority task
+    // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+    if (!iNesting)
+    {
+      // Verify if there is a higher priority task ready to run
+      ChangeContext();
+    }
+  }
+
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Memory Pool Allocator Functions             /////
+/////                                                  /////
+/////  Used as BRTOS_ALLOC / BRTOS_DEALLOC replacement /////
+/////  Must be called inside a critical section        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+void *OSMemPoolTake(INT16U size)
+{
+  INT8U i = 0;
+  BRTOS_MemPool *pont_event = NULL;
+
+  // Selects the pool with the smallest block that fits the size
+  for(i=0;i<BRTOS_MAX_MEMPOOL;i++)
+  {
+    if ((BRTOS_MemPool_Table[i].OSEventAllocated == TRUE) &&
+        (BRTOS_MemPool_Table[i].OSMemBlockSize >= size) &&
+        (BRTOS_MemPool_Table[i].OSMemFree > BRTOS_MemPool_Table[i].OSMemReserved))
+    {
+      if ((pont_event == NULL) || (BRTOS_MemPool_Table[i].OSMemBlockSize < pont_event->OSMemBlockSize))
+      {
+        pont_event = &BRTOS_MemPool_Table[i];
+      }
+    }
+  }
+
+  if (pont_event == NULL)
+  {
+    return NULL;
+  }
+
+  return OSMemPoolPop(pont_event);
+}
+
+
+INT8U OSMemPoolGive(void *block)
+{
+  BRTOS_MemPool *pont_event = OSMemPoolOwner(block);
+
+  if (pont_event == NULL)
+  {
+    return(INVALID_PARAMETERS);
+  }
+
+  // A woken task runs at the next scheduling point
+  (void)OSMemPoolPush(pont_event, block);
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#endif
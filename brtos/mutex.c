@@ -64,6 +64,155 @@
 
 
 #if (BRTOS_MUTEX_EN == 1)
+
+#if (BRTOS_MUTEX_INHERIT_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Mutex Priority Inheritance Function         /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Gives to the owner of inheritance mutexes the priority of the highest task
+// waiting for them, or its original priority if no higher task is waiting.
+// The waiting task is out of the Ready List, so its priority is lent to the
+// owner until the mutex release.
+// pont_event is a mutex owned or just released by the owner task.
+// Must be called inside a critical section
+void OSMutexInherit(BRTOS_Mutex *pont_event, INT8U owner)
+{
+  INT8U i;
+  INT8U iPriority;
+  INT8U target;
+  BRTOS_Mutex *mutex;
+  BRTOS_Mutex *lender = NULL;
+  BRTOS_Mutex *borrower = NULL;
+  
+  if (owner == 0)
+  {
+    return;
+  }
+  
+  iPriority = ContextTask[owner].Priority;
+  target = pont_event->OSOriginalPriority;
+  
+  // Search the lent priority and the highest task waiting for the owner mutexes
+  for(i=0;i<MUTEX_ENTRIES;i++)
+  {
+    mutex = MutexEntry(i);
+    
+    if ((mutex == NULL) || (mutex->OSEventAllocated != TRUE) || (mutex->OSMaxPriority != MUTEX_INHERIT))
+    {
+      continue;
+    }
+    
+    if ((mutex->OSInheritPriority != 0) && ((mutex->OSEventOwner == owner) || (mutex == pont_event)))
+    {
+      lender = mutex;
+    }
+    
+    if ((mutex->OSEventOwner == owner) && (mutex->OSEventWait != 0) && (PrioListHighest(mutex->OSEventWaitList) > target))
+    {
+      target = PrioListHighest(mutex->OSEventWaitList);
+      borrower = mutex;
+    }
+  }
+  
+  // A priority raised by a priority ceiling mutex is kept
+  if ((iPriority != pont_event->OSOriginalPriority) && ((lender == NULL) || (iPriority != lender->OSInheritPriority)))
+  {
+    return;
+  }
+  
+  if (target == iPriority)
+  {
+    return;
+  }
+  
+  // The priority of a task waiting for other event can only change when it is ready to run
+  if (!OSReadyListTest(owner, iPriority))
+  {
+    // The scheduler updates the priority when the owner is ready again
+    OSMutexInheritPending = TRUE;
+    return;
+  }
+  
+  // Give back the lent priority
+  // A shared round-robin priority is not bound to a task, so it is not exchanged
+  if (lender != NULL)
+  {
+    #if (ROUND_ROBIN_EN == 0)
+    PriorityVector[lender->OSInheritPriority] = lender->OSInheritTask;
+    #endif
+    lender->OSInheritPriority = 0;
+  }
+  
+  // Borrow the priority of the highest waiting task
+  if (borrower != NULL)
+  {
+    borrower->OSInheritPriority = target;
+    #if (ROUND_ROBIN_EN == 0)
+    borrower->OSInheritTask = PriorityVector[target];
+    PriorityVector[target] = owner;
+    #endif
+  }
+  
+  // Reallocate the owner priority into the Ready List
+  OSReadyListMove(owner, iPriority, target);
+  
+  ContextTask[owner].Priority = target;
+}
+
+// Updates the priority of the owners that were waiting for other events
+// Must be called inside a critical section
+void OSMutexInheritUpdate(void)
+{
+  INT8U i;
+  BRTOS_Mutex *mutex;
+  
+  // Owners still waiting for other events set it again
+  OSMutexInheritPending = FALSE;
+  
+  for(i=0;i<MUTEX_ENTRIES;i++)
+  {
+    mutex = MutexEntry(i);
+    
+    if ((mutex != NULL) && (mutex->OSEventAllocated == TRUE) && (mutex->OSMaxPriority == MUTEX_INHERIT) &&
+        (mutex->OSEventOwner != 0) && ((mutex->OSEventWait != 0) || (mutex->OSInheritPriority != 0)))
+    {
+      OSMutexInherit(mutex, mutex->OSEventOwner);
+    }
+  }
+}
+
+// Original priority of the task - shared by the other inheritance mutexes it owns
+static INT8U OSMutexOriginalPriority(BRTOS_Mutex *pont_event, INT8U owner)
+{
+  INT8U i;
+  BRTOS_Mutex *mutex;
+  
+  for(i=0;i<MUTEX_ENTRIES;i++)
+  {
+    mutex = MutexEntry(i);
+    if ((mutex != NULL) && (mutex != pont_event) && (mutex->OSEventAllocated == TRUE) &&
+        (mutex->OSMaxPriority == MUTEX_INHERIT) && (mutex->OSEventOwner == owner))
+    {
+      return mutex->OSOriginalPriority;
+    }
+  }
+  
+  return ContextTask[owner].Priority;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
+
+
+
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 /////      Create Mutex Function                       /////
@@ -73,7 +222,9 @@
 INT8U OSMutexCreate (BRTOS_Mutex **event, INT8U HigherPriority)
 {
   OS_SR_SAVE_VAR
+  #if (BRTOS_OBJECT_POOL_EN == 0)
   int i=0;
+  #endif
 
   BRTOS_Mutex *pont_event;
 
@@ -85,17 +236,32 @@ INT8U OSMutexCreate (BRTOS_Mutex **event, INT8U HigherPriority)
   if (currentTask)
      OSEnterCritical();
   
-  if (PriorityVector[HigherPriority] != EMPTY_PRIO)
+  #if (BRTOS_MUTEX_INHERIT_EN == 1)
+  // Priority inheritance mutexes do not reserve a priority
+  if (HigherPriority != MUTEX_INHERIT)
+  #endif
   {
-      // Exit critical Section
-      if (currentTask)
-        OSExitCritical();
-      return BUSY_PRIORITY;                          // The priority is busy
+    if (PriorityVector[HigherPriority] != EMPTY_PRIO)
+    {
+        // Exit critical Section
+        if (currentTask)
+          OSExitCritical();
+        return BUSY_PRIORITY;                          // The priority is busy
+    }
   }
-  
-  // Allocate priority to the mutex
-  PriorityVector[HigherPriority] = MUTEX_PRIO;
 
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Takes a control block from the shared object pool
+  pont_event = (BRTOS_Mutex*)OSObjectAlloc(OBJECT_MUTEX);
+  if (pont_event == NULL)
+  {
+    // Exit critical Section
+    if (currentTask)
+       OSExitCritical();
+
+    return(NO_AVAILABLE_EVENT);
+  }
+  #else
   // Verifica se ainda h blocos de controle de eventos disponveis
   for(i=0;i<=BRTOS_MAX_MUTEX;i++)
   {
@@ -119,15 +285,29 @@ INT8U OSMutexCreate (BRTOS_Mutex **event, INT8U HigherPriority)
       break;      
     }
   }  
+  #endif
     
 
     // Exit Critical
   pont_event->OSEventState = AVAILABLE_RESOURCE;       // Set mutex init value
   pont_event->OSEventWait  = 0;
+  #if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+  pont_event->OSRecursive  = FALSE;
+  pont_event->OSEventCount = 0;
+  #endif
   pont_event->OSMaxPriority = HigherPriority;          // Determina a tarefa de maior prioridade acessando o mutex
-
+  #if (BRTOS_MUTEX_INHERIT_EN == 1)
+  pont_event->OSInheritPriority = 0;
+  pont_event->OSInheritTask = 0;
+  
+  if (HigherPriority != MUTEX_INHERIT)
+  #endif
+  {
+    // Allocate priority to the mutex
+    PriorityVector[HigherPriority] = MUTEX_PRIO;
+  }
   
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
   
   *event = pont_event;
   
@@ -147,6 +327,38 @@ INT8U OSMutexCreate (BRTOS_Mutex **event, INT8U HigherPriority)
 
 
 
+#if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Create Recursive Mutex Function             /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSMutexCreateRecursive (BRTOS_Mutex **event, INT8U HigherPriority)
+{
+  INT8U err;
+  
+  err = OSMutexCreate(event, HigherPriority);
+  
+  // The owner may acquire the new mutex again
+  if (err == ALLOC_EVENT_OK)
+  {
+    (*event)->OSRecursive = TRUE;
+  }
+  
+  return err;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
+
+
+
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 /////      Delete Mutex Function                       /////
@@ -166,14 +378,37 @@ INT8U OSMutexDelete (BRTOS_Mutex **event)
   OSEnterCritical();
   
   pont_event = *event;  
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_MUTEX))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
   pont_event->OSEventAllocated   = 0;
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Gives the control block back to the shared object pool
+  OSObjectFree(pont_event);
+  #endif
   pont_event->OSEventState       = 0;
   pont_event->OSEventOwner       = 0;                        
   pont_event->OSMaxPriority      = 0;                      
   pont_event->OSOriginalPriority = 0;                
   pont_event->OSEventWait        = 0;  
+  #if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+  pont_event->OSRecursive        = FALSE;
+  pont_event->OSEventCount       = 0;
+  #endif
+  #if (BRTOS_MUTEX_INHERIT_EN == 1)
+  pont_event->OSInheritPriority  = 0;
+  pont_event->OSInheritTask      = 0;
+  #endif
   
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
   
   *event = NULL;
   
@@ -217,13 +452,21 @@ INT8U OSMutexAcquire(BRTOS_Mutex *pont_event)
       return(NULL_EVENT_POINTER);
     }
   #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
     
   // Enter Critical Section
   OSEnterCritical();
 
   #if (ERROR_CHECK == 1)
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_MUTEX))
     {
       // Exit Critical Section
       OSExitCritical();      
@@ -244,6 +487,19 @@ INT8U OSMutexAcquire(BRTOS_Mutex *pont_event)
   // Verifies if the task is trying to acquire the mutex again
   if (currentTask == pont_event->OSEventOwner) 
   {
+    #if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+    // Counts the nested acquisition of a recursive mutex
+    if (pont_event->OSRecursive == TRUE)
+    {
+      if (pont_event->OSEventCount == (INT8U)0xFF)
+      {
+        OSExitCritical();
+        return ERR_MUTEX_OVF;
+      }
+      pont_event->OSEventCount++;
+    }
+    #endif
+    
     // It is already the mutex owner
     OSExitCritical();
     return OK;
@@ -262,6 +518,17 @@ INT8U OSMutexAcquire(BRTOS_Mutex *pont_event)
     // Performs the temporary exchange of mutex owner priority, if needed        //
     ///////////////////////////////////////////////////////////////////////////////
     
+    #if (BRTOS_MUTEX_INHERIT_EN == 1)
+    if (pont_event->OSMaxPriority == MUTEX_INHERIT)
+    {
+      // The priority is only raised when a higher priority task waits for the mutex
+      pont_event->OSOriginalPriority = OSMutexOriginalPriority(pont_event, currentTask);
+      
+      OSExitCritical();
+      return OK;
+    }
+    #endif
+    
     // Backup the original task priority
     pont_event->OSOriginalPriority = ContextTask[currentTask].Priority;
     
@@ -273,10 +540,8 @@ INT8U OSMutexAcquire(BRTOS_Mutex *pont_event)
       // Priority vector change       
       PriorityVector[pont_event->OSMaxPriority] = currentTask;
       
-      // Remove "original priority current task" from the Ready List
-      OSReadyList = OSReadyList & ~(PriorityMask[pont_event->OSOriginalPriority]);
-      // Put the "max priority current task" into Ready List
-      OSReadyList = OSReadyList | (PriorityMask[pont_event->OSMaxPriority]);
+      // Move the current task from the original priority to the max priority into the Ready List
+      OSReadyListMove(currentTask, pont_event->OSOriginalPriority, pont_event->OSMaxPriority);
     }
     
     OSExitCritical();
@@ -290,7 +555,7 @@ INT8U OSMutexAcquire(BRTOS_Mutex *pont_event)
     pont_event->OSEventWait++;
     
     // Allocates the current task on the mutex wait list
-    pont_event->OSEventWaitList = pont_event->OSEventWaitList | (PriorityMask[iPriority]);
+    OSWaitListAdd(pont_event->OSEventWaitList, currentTask, iPriority);
       
     // Task entered suspended state, waiting for mutex release
     #if (VERBOSE == 1)
@@ -299,7 +564,15 @@ INT8U OSMutexAcquire(BRTOS_Mutex *pont_event)
     #endif
 
     // Remove current task from the Ready List
-    OSReadyList = OSReadyList & ~(PriorityMask[iPriority]);
+    OSReadyListRemove(currentTask, iPriority);
+    
+    #if (BRTOS_MUTEX_INHERIT_EN == 1)
+    // Lends the current task priority to the mutex owner
+    if (pont_event->OSMaxPriority == MUTEX_INHERIT)
+    {
+      OSMutexInherit(pont_event, pont_event->OSEventOwner);
+    }
+    #endif
             
     // Change Context - Returns on mutex release
     ChangeContext();
@@ -309,6 +582,20 @@ INT8U OSMutexAcquire(BRTOS_Mutex *pont_event)
     // Enter Critical Section
     OSEnterCritical();    
     
+    #if (BRTOS_MUTEX_INHERIT_EN == 1)
+    if (pont_event->OSMaxPriority == MUTEX_INHERIT)
+    {
+      pont_event->OSOriginalPriority = OSMutexOriginalPriority(pont_event, currentTask);
+      pont_event->OSEventOwner = currentTask;
+      
+      // A higher priority task may have started to wait while the mutex had no owner
+      OSMutexInherit(pont_event, currentTask);
+      
+      OSExitCritical();
+      return OK;
+    }
+    #endif
+    
     // Current task becomes the temporary owner of the mutex
     pont_event->OSEventOwner = currentTask;
     
@@ -327,10 +614,8 @@ INT8U OSMutexAcquire(BRTOS_Mutex *pont_event)
       // Priority vector change
       PriorityVector[pont_event->OSMaxPriority] = currentTask;
       
-      // Remove "original priority current task" from the Ready List
-      OSReadyList = OSReadyList & ~(PriorityMask[iPriority]);
-      // Put the "max priority current task" into Ready List
-      OSReadyList = OSReadyList | (PriorityMask[pont_event->OSMaxPriority]);
+      // Move the current task from the original priority to the max priority into the Ready List
+      OSReadyListMove(currentTask, iPriority, pont_event->OSMaxPriority);
     }
     
     OSExitCritical();
@@ -349,17 +634,100 @@ INT8U OSMutexAcquire(BRTOS_Mutex *pont_event)
 
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      Mutex Release Function                      /////
+/////      Mutex Give Function                         /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U OSMutexRelease(BRTOS_Mutex *pont_event)
+// Restores the owner priority and gives the mutex to the highest priority
+// waiting task, or makes it available. Called by the mutex owner.
+// Returns TRUE if a waiting task was released
+// Must be called inside a critical section
+INT8U OSMutexGive(BRTOS_Mutex *pont_event)
 {
-  OS_SR_SAVE_VAR
   INT8U iPriority = (INT8U)0;
-  #if (VERBOSE == 1)
   INT8U TaskSelect = 0;
+  
+  // Returns to the original priority, if needed
+  // Copy backuped original priority to the task context
+  iPriority = ContextTask[currentTask].Priority;
+  #if (BRTOS_MUTEX_INHERIT_EN == 1)
+  if (pont_event->OSMaxPriority == MUTEX_INHERIT)
+  {
+    // Release mutex ownership
+    pont_event->OSEventOwner = 0;
+    
+    // Gives back the lent priority. The tasks waiting for other owned mutexes keep lending their priority.
+    OSMutexInherit(pont_event, currentTask);
+  }
+  else
+  #endif
+  if (iPriority != pont_event->OSOriginalPriority)
+  {              
+    // Since current task is executing with another priority, reallocate its priority to the original
+    // into the Ready List
+    // Move the current task from the max priority to the original priority into the Ready List
+    OSReadyListMove(currentTask, iPriority, pont_event->OSOriginalPriority);
+    
+    ContextTask[currentTask].Priority = pont_event->OSOriginalPriority;
+  }
+
+  // Release mutex ownership
+  pont_event->OSEventOwner = 0;
+  
+  // See if any task is waiting for mutex release
+  if (pont_event->OSEventWait != 0)
+  {
+    // Selects the highest priority task
+    iPriority = PrioListHighest(pont_event->OSEventWaitList);
+    TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
+
+    // Remove the selected task from the mutex wait list
+    OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
+    
+    // Decreases the mutex wait list counter
+    pont_event->OSEventWait--;
+         
+    // Indicates that selected task is ready to run
+    #if (VERBOSE == 1)
+    ContextTask[TaskSelect].State = READY;    
+    #endif    
+    
+    // Put the selected task into Ready List
+    OSReadyListAdd(TaskSelect, iPriority);
+        
+    return TRUE;
+  }
+      
+  // Release Mutex
+  pont_event->OSEventState = AVAILABLE_RESOURCE;
+  #if (BRTOS_MUTEX_INHERIT_EN == 1)
+  if (pont_event->OSMaxPriority != MUTEX_INHERIT)
   #endif
+  {
+    PriorityVector[pont_event->OSMaxPriority] = MUTEX_PRIO;
+  }
+  
+  return FALSE;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Mutex Release Function                      /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSMutexRelease(BRTOS_Mutex *pont_event)
+{
+  OS_SR_SAVE_VAR
   
   #if (ERROR_CHECK == 1)      
     /// Can not use mutex pend function from interrupt handling code
@@ -380,7 +748,7 @@ INT8U OSMutexRelease(BRTOS_Mutex *pont_event)
      
   #if (ERROR_CHECK == 1)        
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_MUTEX))
     {
       // Exit Critical Section
       OSExitCritical();
@@ -408,61 +776,26 @@ INT8U OSMutexRelease(BRTOS_Mutex *pont_event)
     return ERR_EVENT_OWNER;
   }  
   
-  
-  // Returns to the original priority, if needed
-  // Copy backuped original priority to the task context
-  iPriority = ContextTask[currentTask].Priority;
-  if (iPriority != pont_event->OSOriginalPriority)
-  {              
-    // Since current task is executing with another priority, reallocate its priority to the original
-    // into the Ready List
-    // Remove "max priority current task" from the Ready List
-    OSReadyList = OSReadyList & ~(PriorityMask[iPriority]);
-    // Put the "original priority current task" into Ready List
-    OSReadyList = OSReadyList | (PriorityMask[pont_event->OSOriginalPriority]);
-    
-    ContextTask[currentTask].Priority = pont_event->OSOriginalPriority;
+  #if (BRTOS_MUTEX_RECURSIVE_EN == 1)
+  // Only the release of the first acquisition releases the mutex
+  if (pont_event->OSEventCount != 0)
+  {
+    pont_event->OSEventCount--;
+    OSExitCritical();
+    return OK;
   }
-
-  // Release mutex ownership
-  pont_event->OSEventOwner = 0;
+  #endif
   
-  // See if any task is waiting for mutex release
-  if (pont_event->OSEventWait != 0)
+  
+  // Releases the mutex to the highest priority waiting task
+  if (OSMutexGive(pont_event) == TRUE)
   {
-    // Selects the highest priority task
-    iPriority = SAScheduler(pont_event->OSEventWaitList);
-
-    // Remove the selected task from the mutex wait list
-    pont_event->OSEventWaitList = pont_event->OSEventWaitList & ~(PriorityMask[iPriority]);
-    
-    // Decreases the mutex wait list counter
-    pont_event->OSEventWait--;
-         
-    // Indicates that selected task is ready to run
-    #if (VERBOSE == 1)
-    TaskSelect = PriorityVector[iPriority];
-    ContextTask[TaskSelect].State = READY;    
-    #endif    
-    
-    // Put the selected task into Ready List
-    OSReadyList = OSReadyList | (PriorityMask[iPriority]);
-        
     // Verify if there is a higher priority task ready to run
     ChangeContext();
-
-    // Exit Critical Section
-    OSExitCritical();
-      
-    return OK;
   }
-      
-  // Release Mutex
-  pont_event->OSEventState = AVAILABLE_RESOURCE;
-  PriorityVector[pont_event->OSMaxPriority] = MUTEX_PRIO;
-      
+  
   // Exit Critical Section
-  OSExitCritical();      
+  OSExitCritical();
   
   return OK;
 }
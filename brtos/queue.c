@@ -75,6 +75,155 @@
 #endif
 
 
+#if (BRTOS_POST_WAIT_EN == 1)
+  #define QUEUE_SEND_RESERVED(pont_event)   ((pont_event)->OSEventSendReserved)
+#else
+  #define QUEUE_SEND_RESERVED(pont_event)   0
+#endif
+
+#if (BRTOS_DQUEUE_SLOT_EN == 1)
+  #define DQUEUE_SLOT_RESERVED(cqueue)      ((cqueue)->OSQReserved)
+  #define DQUEUE_SLOT_PEEKED(cqueue)        ((cqueue)->OSQPeeked)
+#else
+  #define DQUEUE_SLOT_RESERVED(cqueue)      0
+  #define DQUEUE_SLOT_PEEKED(cqueue)        0
+#endif
+
+
+#if (BRTOS_QUEUE_EN == 1) && (BRTOS_POST_WAIT_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Queue Send Wait Internal Functions          /////
+/////                                                  /////
+/////  Must be called inside a critical section        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Releases up to slots tasks waiting for space in the queue, from the highest priority
+// Each released task keeps one slot reserved until it runs
+// Returns the number of released tasks
+static INT16U OSQueueSendWakeup(BRTOS_Queue *pont_event, INT16U slots)
+{
+  INT8U  iPriority;
+  INT16U woken = 0;
+  INT8U TaskSelect = 0;
+  
+  while ((woken < slots) && (pont_event->OSEventSendWait != 0))
+  {
+    // Selects the highest priority task
+    iPriority = PrioListHighest(pont_event->OSEventSendWaitList);
+    TaskSelect = OSWaitListTask(pont_event->OSEventSendWaitList, iPriority);
+
+    // Remove the selected task from the queue send wait list
+    OSWaitListRemove(pont_event->OSEventSendWaitList, TaskSelect, iPriority);
+    
+    // Decreases the queue send wait list counter
+    pont_event->OSEventSendWait--;
+    
+    // Keeps the slot to the selected task
+    pont_event->OSEventSendReserved++;
+    #if (TASK_RESERVATION_EN == 1)
+    ContextTask[TaskSelect].Reservation = pont_event;
+    #endif
+    
+    // Put the selected task into Ready List
+    #if (VERBOSE == 1)
+    ContextTask[TaskSelect].State = READY;
+    #endif
+    
+    OSReadyListAdd(TaskSelect, iPriority);
+    woken++;
+  }
+  
+  return woken;
+}
+
+
+// Puts the current task into the queue send wait list
+// The caller must change the context after this function
+static void OSQueueSendSuspend(BRTOS_Queue *pont_event, TickType time_wait)
+{
+  ContextType *Task = (ContextType*)&ContextTask[currentTask];
+  
+  // Increases the queue send wait list counter
+  pont_event->OSEventSendWait++;
+  
+  // Allocates the current task on the queue send wait list
+  OSWaitListAdd(pont_event->OSEventSendWaitList, currentTask, Task->Priority);
+  
+  // Task entered suspended state, waiting for space in the queue
+  #if (VERBOSE == 1)
+  Task->State = SUSPENDED;
+  Task->SuspendedType = QUEUE;
+  #endif
+  
+  // Remove current task from the Ready List
+  OSReadyListRemove(currentTask, Task->Priority);
+  
+  // Set timeout overflow
+  if (time_wait)
+  {  
+    Task->TimeToWait = OSWakeTimeCompute(time_wait);
+    
+    // Put task into delay list
+    IncludeTaskIntoDelayList();
+  } else
+  {
+    Task->TimeToWait = NO_TIMEOUT;
+  }
+}
+
+
+// Verifies why the current task left the queue send wait list
+// Returns OK when the task got a reserved slot, or TIMEOUT
+static INT8U OSQueueSendResume(BRTOS_Queue *pont_event, TickType time_wait)
+{
+  ContextType *Task = (ContextType*)&ContextTask[currentTask];
+  
+  if (time_wait)
+  {
+    // Verify if the reason of task wake up was timeout
+    if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+    {
+      // Test if both timeout and pend have occured before arrive here
+      if (OSWaitListTest(pont_event->OSEventSendWaitList, currentTask, Task->Priority))
+      {
+        // Remove the task from the queue send wait list
+        OSWaitListRemove(pont_event->OSEventSendWaitList, currentTask, Task->Priority);
+        
+        // Decreases the queue send wait list counter
+        pont_event->OSEventSendWait--;
+        
+        // Indicates queue timeout
+        return TIMEOUT;
+      }
+    }
+    else
+    {
+      // Remove the time to wait condition
+      Task->TimeToWait = NO_TIMEOUT;
+      
+      // Remove from delay list
+      RemoveFromDelayList();
+    }
+  }
+  
+  // Takes the slot kept by the pend function
+  pont_event->OSEventSendReserved--;
+  #if (TASK_RESERVATION_EN == 1)
+  Task->Reservation = NULL;
+  #endif
+  
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
+
 #if (BRTOS_QUEUE_EN == 1)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -85,7 +234,9 @@
 INT8U OSQueueCreate(OS_QUEUE *cqueue, INT16U size, BRTOS_Queue **event)
 {
   OS_SR_SAVE_VAR
+  #if (BRTOS_OBJECT_POOL_EN == 0)
   INT16S i=0;
+  #endif
   BRTOS_Queue *pont_event;
 
   if (iNesting > 0) {                                // See if caller is an interrupt
@@ -111,6 +262,18 @@ INT8U OSQueueCreate(OS_QUEUE *cqueue, INT16U size, BRTOS_Queue **event)
        return NO_MEMORY;
   }  
   
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Takes a control block from the shared object pool
+  pont_event = (BRTOS_Queue*)OSObjectAlloc(OBJECT_QUEUE);
+  if (pont_event == NULL)
+  {
+    // Exit critical Section
+    if (currentTask)
+       OSExitCritical();
+
+    return(NO_AVAILABLE_EVENT);
+  }
+  #else
   // Verifica se ainda h blocos de controle de eventos disponveis
   for(i=0;i<=BRTOS_MAX_QUEUE;i++)
   {
@@ -134,6 +297,7 @@ INT8U OSQueueCreate(OS_QUEUE *cqueue, INT16U size, BRTOS_Queue **event)
       break;      
     }
   } 
+  #endif
   
   // Configura dados de evento de lista
   cqueue->OSQStart    = (INT8U *)&QUEUE_STACK[iQueueAddress];
@@ -149,7 +313,15 @@ INT8U OSQueueCreate(OS_QUEUE *cqueue, INT16U size, BRTOS_Queue **event)
   pont_event->OSEventWait = 0;
   
   
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
+  #if (BRTOS_SET_EN == 1)
+  pont_event->OSEventSet = NULL;
+  #endif
+  #if (BRTOS_POST_WAIT_EN == 1)
+  pont_event->OSEventSendWait     = 0;
+  pont_event->OSEventSendReserved = 0;
+  PrioListInit(pont_event->OSEventSendWaitList);
+  #endif
   
   *event = pont_event;
   
@@ -303,6 +475,17 @@ INT8U OSCleanQueue(BRTOS_Queue *pont_event)
   cqueue->OSQIn = cqueue->OSQStart;
   cqueue->OSQOut = cqueue->OSQStart;
   
+  #if (BRTOS_POST_WAIT_EN == 1)
+  // Release the tasks waiting for space in the queue
+  if (OSQueueSendWakeup(pont_event, (INT16U)(cqueue->OSQSize - pont_event->OSEventSendReserved)))
+  {
+    if (!iNesting)
+    {
+      ChangeContext();
+    }
+  }
+  #endif
+  
   // Exit Critical Section
   #if (NESTING_INT == 0)
   if (!iNesting)
@@ -327,11 +510,10 @@ INT8U OSCleanQueue(BRTOS_Queue *pont_event)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, INT16U time_wait)
+INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, TickType time_wait)
 {
   OS_SR_SAVE_VAR
   INT8U iPriority = 0;
-  INT32U timeout;
   ContextType *Task;
   OS_QUEUE *cqueue = pont_event->OSEventPointer;
    
@@ -348,13 +530,21 @@ INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, INT16U time_wait)
       return(NULL_EVENT_POINTER);
     }
   #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
     
   // Enter Critical Section
   OSEnterCritical();
 
   #if (ERROR_CHECK == 1)
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
     {
       // Exit Critical Section
       OSExitCritical();
@@ -387,6 +577,14 @@ INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, INT16U time_wait)
     // Decreases queue entries
     cqueue->OSQEntries--;
     
+    #if (BRTOS_POST_WAIT_EN == 1)
+    // Release a task waiting for space in the queue
+    if (OSQueueSendWakeup(pont_event, 1))
+    {
+      ChangeContext();
+    }
+    #endif
+    
     // Exit Critical Section
     OSExitCritical();
     return READ_BUFFER_OK;
@@ -402,7 +600,7 @@ INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, INT16U time_wait)
     pont_event->OSEventWait++;
     
     // Allocates the current task on the queue wait list
-    pont_event->OSEventWaitList = pont_event->OSEventWaitList | (PriorityMask[iPriority]);
+    OSWaitListAdd(pont_event->OSEventWaitList, currentTask, iPriority);
   
     // Task entered suspended state, waiting for queue post
     #if (VERBOSE == 1)
@@ -411,21 +609,12 @@ INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, INT16U time_wait)
     #endif
 
     // Remove current task from the Ready List
-    OSReadyList = OSReadyList & ~(PriorityMask[iPriority]);
+    OSReadyListRemove(currentTask, iPriority);
   
     // Set timeout overflow
     if (time_wait)
     {  
-      timeout = (INT32U)((INT32U)OSGetCount() + (INT32U)time_wait);
-      
-      if (timeout >= TICK_COUNT_OVERFLOW)
-      {
-        Task->TimeToWait = (INT16U)(timeout - TICK_COUNT_OVERFLOW);
-      }
-      else
-      {
-        Task->TimeToWait = (INT16U)timeout;
-      }
+      Task->TimeToWait = OSWakeTimeCompute(time_wait);
     
       // Put task into delay list
       IncludeTaskIntoDelayList();
@@ -448,10 +637,10 @@ INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, INT16U time_wait)
         if(Task->TimeToWait == EXIT_BY_TIMEOUT)
         {
             // Test if both timeout and post have occured before arrive here
-            if ((pont_event->OSEventWaitList & PriorityMask[iPriority]))
+            if (OSWaitListTest(pont_event->OSEventWaitList, currentTask, iPriority))
             {
               // Remove the task from the queue wait list
-              pont_event->OSEventWaitList = pont_event->OSEventWaitList & ~(PriorityMask[iPriority]);
+              OSWaitListRemove(pont_event->OSEventWaitList, currentTask, iPriority);
               
               // Decreases the queue wait list counter
               pont_event->OSEventWait--;
@@ -487,6 +676,14 @@ INT8U OSQueuePend (BRTOS_Queue *pont_event, INT8U* pdata, INT16U time_wait)
     // Decreases queue entries
     cqueue->OSQEntries--;
     
+    #if (BRTOS_POST_WAIT_EN == 1)
+    // Release a task waiting for space in the queue
+    if (OSQueueSendWakeup(pont_event, 1))
+    {
+      ChangeContext();
+    }
+    #endif
+    
     // Exit Critical Section
     OSExitCritical();
     return READ_BUFFER_OK;
@@ -512,9 +709,7 @@ INT8U OSQueuePost(BRTOS_Queue *pont_event, INT8U data)
 {
   OS_SR_SAVE_VAR
   INT8U iPriority = (INT8U)0;
-  #if (VERBOSE == 1)
   INT8U TaskSelect = 0;
-  #endif
   OS_QUEUE *cqueue = pont_event->OSEventPointer;
   
   #if (ERROR_CHECK == 1)    
@@ -533,7 +728,7 @@ INT8U OSQueuePost(BRTOS_Queue *pont_event, INT8U data)
      
   #if (ERROR_CHECK == 1)        
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
     {
       // Exit Critical Section
       #if (NESTING_INT == 0)
@@ -558,7 +753,7 @@ INT8U OSQueuePost(BRTOS_Queue *pont_event, INT8U data)
   #endif       
   
   // Checks for queue overflow
-  if (cqueue->OSQEntries < cqueue->OSQSize)
+  if ((cqueue->OSQEntries + QUEUE_SEND_RESERVED(pont_event)) < cqueue->OSQSize)
   {  
     // If no, increases the queue entries
     cqueue->OSQEntries++;
@@ -589,21 +784,21 @@ INT8U OSQueuePost(BRTOS_Queue *pont_event, INT8U data)
   if (pont_event->OSEventWait != 0)
   {
     // Selects the highest priority task
-    iPriority = SAScheduler(pont_event->OSEventWaitList);    
+    iPriority = PrioListHighest(pont_event->OSEventWaitList);    
+    TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
 
     // Remove the selected task from the queue wait list
-    pont_event->OSEventWaitList = pont_event->OSEventWaitList & ~(PriorityMask[iPriority]);
+    OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
     
     // Decreases the queue wait list counter
     pont_event->OSEventWait--;
     
     // Put the selected task into Ready List
     #if (VERBOSE == 1)
-    TaskSelect = PriorityVector[iPriority];
     ContextTask[TaskSelect].State = READY;
     #endif
     
-    OSReadyList = OSReadyList | (PriorityMask[iPriority]);
+    OSReadyListAdd(TaskSelect, iPriority);
     
     // If outside of an interrupt service routine, change context to the highest priority task
     // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
@@ -623,6 +818,14 @@ INT8U OSQueuePost(BRTOS_Queue *pont_event, INT8U data)
   }
   else
   {
+    #if (BRTOS_SET_EN == 1)
+    // Signals the set that holds this queue
+    if (OSSetSignal(pont_event->OSEventSet, pont_event) && !iNesting)
+    {
+      ChangeContext();
+    }
+    #endif
+    
     // Exit Critical Section
     #if (NESTING_INT == 0)
     if (!iNesting)
@@ -638,6 +841,152 @@ INT8U OSQueuePost(BRTOS_Queue *pont_event, INT8U data)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
+
+
+
+
+#if (BRTOS_POST_WAIT_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Post Queue With Timeout Function            /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSQueuePostWait(BRTOS_Queue *pont_event, INT8U data, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U iPriority = (INT8U)0;
+  INT8U TaskSelect = 0;
+  OS_QUEUE *cqueue;
+  
+  #if (ERROR_CHECK == 1)
+    /// Can not wait for space in the queue from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+    
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+  
+  // Enter Critical Section
+  OSEnterCritical();
+  
+  cqueue = pont_event->OSEventPointer;
+  
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+  
+  // BRTOS TRACE SUPPORT
+  #if (OSTRACE == 1) 
+      #if(OS_TRACE_BY_TASK == 1)
+      Update_OSTrace(currentTask, QUEUEPOST);
+      #else
+      Update_OSTrace(ContextTask[currentTask].Priority, QUEUEPOST);
+      #endif
+  #endif
+  
+  // Verify if the queue is full, including the slots kept to released senders
+  if ((cqueue->OSQEntries + pont_event->OSEventSendReserved) >= cqueue->OSQSize)
+  {
+    OSQueueSendSuspend(pont_event, time_wait);
+    
+    // Change Context - Returns on time overflow or queue pend
+    ChangeContext();
+    
+    // Exit Critical Section
+    OSExitCritical();
+    // Enter Critical Section
+    OSEnterCritical();
+    
+    if (OSQueueSendResume(pont_event, time_wait) == TIMEOUT)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      
+      // Indicates queue timeout
+      return TIMEOUT;
+    }
+  }
+  
+  // Increases the queue entries
+  cqueue->OSQEntries++;
+  
+  // Verify for input pointer overflow
+  if (cqueue->OSQIn == cqueue->OSQEnd)
+    cqueue->OSQIn = cqueue->OSQStart;
+  
+  // copy data into the queue
+  *cqueue->OSQIn = data;
+  
+  // increases the input pointer
+  cqueue->OSQIn++;
+  
+  // See if any task is waiting for new data in the queue
+  if (pont_event->OSEventWait != 0)
+  {
+    // Selects the highest priority task
+    iPriority = PrioListHighest(pont_event->OSEventWaitList);    
+    TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
+
+    // Remove the selected task from the queue wait list
+    OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
+    
+    // Decreases the queue wait list counter
+    pont_event->OSEventWait--;
+    
+    // Put the selected task into Ready List
+    #if (VERBOSE == 1)
+    ContextTask[TaskSelect].State = READY;
+    #endif
+    
+    OSReadyListAdd(TaskSelect, iPriority);
+    
+    // Verify if there is a higher priority task ready to run
+    ChangeContext();
+  }
+  #if (BRTOS_SET_EN == 1)
+  else
+  {
+    // Signals the set that holds this queue
+    if (OSSetSignal(pont_event->OSEventSet, pont_event))
+    {
+      ChangeContext();
+    }
+  }
+  #endif
+  
+  // Exit Critical Section
+  OSExitCritical();
+  
+  return WRITE_BUFFER_OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
 #endif
 
 
@@ -652,7 +1001,9 @@ INT8U OSQueuePost(BRTOS_Queue *pont_event, INT8U data)
 INT8U OSQueue16Create(OS_QUEUE_16 *cqueue, INT16U size, BRTOS_Queue **event)
 {
   OS_SR_SAVE_VAR
+  #if (BRTOS_OBJECT_POOL_EN == 0)
   INT16S i=0;
+  #endif
   BRTOS_Queue *pont_event;
 
   if (iNesting > 0) {                                // See if caller is an interrupt
@@ -678,6 +1029,18 @@ INT8U OSQueue16Create(OS_QUEUE_16 *cqueue, INT16U size, BRTOS_Queue **event)
        return NO_MEMORY;
   }  
   
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Takes a control block from the shared object pool
+  pont_event = (BRTOS_Queue*)OSObjectAlloc(OBJECT_QUEUE);
+  if (pont_event == NULL)
+  {
+    // Exit critical Section
+    if (currentTask)
+       OSExitCritical();
+
+    return(NO_AVAILABLE_EVENT);
+  }
+  #else
   // Verifica se ainda h blocos de controle de eventos disponveis
   for(i=0;i<=BRTOS_MAX_QUEUE;i++)
   {
@@ -701,6 +1064,7 @@ INT8U OSQueue16Create(OS_QUEUE_16 *cqueue, INT16U size, BRTOS_Queue **event)
       break;      
     }
   } 
+  #endif
   
   // Configura dados de evento de lista
   cqueue->OSQStart    = (INT16U *)&QUEUE_STACK[iQueueAddress];
@@ -714,7 +1078,15 @@ INT8U OSQueue16Create(OS_QUEUE_16 *cqueue, INT16U size, BRTOS_Queue **event)
   // Aloca tipo de evento e dados do evento
   pont_event->OSEventPointer = cqueue;
   pont_event->OSEventWait = 0;    
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
+  #if (BRTOS_SET_EN == 1)
+  pont_event->OSEventSet = NULL;
+  #endif
+  #if (BRTOS_POST_WAIT_EN == 1)
+  pont_event->OSEventSendWait     = 0;
+  pont_event->OSEventSendReserved = 0;
+  PrioListInit(pont_event->OSEventSendWaitList);
+  #endif
   
   *event = pont_event;
   
@@ -899,7 +1271,9 @@ INT8U OSCleanQueue16(OS_QUEUE_16 *cqueue)
 INT8U OSQueue32Create(OS_QUEUE_32 *cqueue, INT16U size, BRTOS_Queue **event)
 {
   OS_SR_SAVE_VAR
+  #if (BRTOS_OBJECT_POOL_EN == 0)
   INT16S i=0;
+  #endif
   BRTOS_Queue *pont_event;
 
   if (iNesting > 0) {                                // See if caller is an interrupt
@@ -919,6 +1293,18 @@ INT8U OSQueue32Create(OS_QUEUE_32 *cqueue, INT16U size, BRTOS_Queue **event)
        return NO_MEMORY;
   }  
   
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Takes a control block from the shared object pool
+  pont_event = (BRTOS_Queue*)OSObjectAlloc(OBJECT_QUEUE);
+  if (pont_event == NULL)
+  {
+    // Exit critical Section
+    if (currentTask)
+       OSExitCritical();
+
+    return(NO_AVAILABLE_EVENT);
+  }
+  #else
   // Verifica se ainda h blocos de controle de eventos disponveis
   for(i=0;i<=BRTOS_MAX_QUEUE;i++)
   {
@@ -942,6 +1328,7 @@ INT8U OSQueue32Create(OS_QUEUE_32 *cqueue, INT16U size, BRTOS_Queue **event)
       break;      
     }
   } 
+  #endif
   
   // Configura dados de evento de lista
   cqueue->OSQStart    = (INT32U *)&QUEUE_STACK[iQueueAddress];
@@ -955,7 +1342,15 @@ INT8U OSQueue32Create(OS_QUEUE_32 *cqueue, INT16U size, BRTOS_Queue **event)
   // Aloca tipo de evento e dados do evento
   pont_event->OSEventPointer = cqueue;
   pont_event->OSEventWait = 0;    
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
+  #if (BRTOS_SET_EN == 1)
+  pont_event->OSEventSet = NULL;
+  #endif
+  #if (BRTOS_POST_WAIT_EN == 1)
+  pont_event->OSEventSendWait     = 0;
+  pont_event->OSEventSendReserved = 0;
+  PrioListInit(pont_event->OSEventSendWaitList);
+  #endif
   
   *event = pont_event;
   
@@ -1127,6 +1522,19 @@ INT8U OSCleanQueue32(OS_QUEUE_32 *cqueue)
 
 
 #if (BRTOS_DYNAMIC_QUEUE_ENABLED == 1)
+#include <string.h>
+
+#if (BRTOS_DQUEUE_MEMPOOL_EN == 1)
+
+#if (BRTOS_MEMPOOL_EN != 1)
+	#error("BRTOS_DQUEUE_MEMPOOL_EN requires BRTOS_MEMPOOL_EN in BRTOSConfig.h file !!!")
+#endif
+
+///// The dynamic queues are allocated from the memory pools
+#define DQUEUE_ALLOC(size)      OSMemPoolTake((INT16U)(size))
+#define DQUEUE_DEALLOC(block)   (void)OSMemPoolGive(block)
+
+#else
 #include <stdlib.h>
 
 ///// Memory allocation definition tests
@@ -1138,17 +1546,237 @@ INT8U OSCleanQueue32(OS_QUEUE_32 *cqueue)
 	#error("You must define the BRTOS memory deallocation method in BRTOSConfig.h file !!!")
 #endif
 
+#define DQUEUE_ALLOC(size)      BRTOS_ALLOC(size)
+#define DQUEUE_DEALLOC(block)   BRTOS_DEALLOC(block)
+
+#endif
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
-/////      Create Dynamic Queue Function               /////
+/////      Dynamic Queue Internal Functions            /////
+/////                                                  /////
+/////  Must be called inside a critical section        /////
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U OSDQueueCreate(INT16U queue_length, OS_CPU_TYPE type_size, BRTOS_Queue **event)
+// Copies one queue element
+// The 1, 2, 4 and 8 bytes sizes (including pointers) have constant size copies,
+// inlined by the compiler as word moves when the target allows
+static void OSDQueueCopy(INT8U *dst, const INT8U *src, INT16U size)
 {
-  OS_SR_SAVE_VAR
-  INT16S      i             = 0;
-  INT16U      size_in_bytes = 0;
+  switch(size)
+  {
+    case 1:
+      *dst = *src;
+      break;
+    case 2:
+      memcpy(dst, src, 2);
+      break;
+    case 4:
+      memcpy(dst, src, 4);
+      break;
+    case 8:
+      memcpy(dst, src, 8);
+      break;
+    default:
+      memcpy(dst, src, size);
+      break;
+  }
+}
+
+
+// Copies one element into the queue input
+static void OSDQueueWrite(OS_DQUEUE *cqueue, const INT8U *src)
+{
+  // Verify for input pointer overflow
+  if (cqueue->OSQIn == cqueue->OSQEnd)
+    cqueue->OSQIn = cqueue->OSQStart;
+  
+  OSDQueueCopy(cqueue->OSQIn, src, cqueue->OSQTSize);
+  cqueue->OSQIn += cqueue->OSQTSize;
+}
+
+
+// Copies one element from the queue output
+static void OSDQueueRead(OS_DQUEUE *cqueue, INT8U *dst)
+{
+  // Verify for output pointer overflow
+  if (cqueue->OSQOut == cqueue->OSQEnd)
+    cqueue->OSQOut = cqueue->OSQStart;
+  
+  OSDQueueCopy(dst, cqueue->OSQOut, cqueue->OSQTSize);
+  cqueue->OSQOut += cqueue->OSQTSize;
+}
+
+
+// Returns the number of free slots for new elements
+// The slots kept to released senders and to the consumer are not free, and
+// there is no free slot while the producer keeps the input slot reserved
+static INT16U OSDQueueFree(BRTOS_Queue *pont_event, OS_DQUEUE *cqueue)
+{
+  #if (BRTOS_POST_WAIT_EN == 0)
+  (void)pont_event;
+  #endif
+  
+  if (DQUEUE_SLOT_RESERVED(cqueue))
+  {
+    return 0;
+  }
+  
+  return (INT16U)(cqueue->OSQLength - cqueue->OSQEntries - QUEUE_SEND_RESERVED(pont_event) - DQUEUE_SLOT_PEEKED(cqueue));
+}
+
+
+// Releases up to count waiting tasks, from the highest priority
+// Returns the number of released tasks
+static INT16U OSDQueueWakeup(BRTOS_Queue *pont_event, INT16U count)
+{
+  INT8U  iPriority;
+  INT16U woken = 0;
+  INT8U TaskSelect = 0;
+  
+  while ((woken < count) && (pont_event->OSEventWait != 0))
+  {
+    // Selects the highest priority task
+    iPriority = PrioListHighest(pont_event->OSEventWaitList);    
+    TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
+
+    // Remove the selected task from the queue wait list
+    OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
+    
+    // Decreases the queue wait list counter
+    pont_event->OSEventWait--;
+    
+    // Put the selected task into Ready List
+    #if (VERBOSE == 1)
+    ContextTask[TaskSelect].State = READY;
+    #endif
+    
+    OSReadyListAdd(TaskSelect, iPriority);
+    woken++;
+  }
+  
+  return woken;
+}
+
+
+// Puts the current task into the queue wait list until the wake time
+// The caller must change the context after this function
+static void OSDQueueSuspend(BRTOS_Queue *pont_event, TickType wake_time)
+{
+  ContextType *Task = (ContextType*)&ContextTask[currentTask];
+  
+  // Increases the queue wait list counter
+  pont_event->OSEventWait++;
+  
+  // Allocates the current task on the queue wait list
+  OSWaitListAdd(pont_event->OSEventWaitList, currentTask, Task->Priority);
+  
+  // Task entered suspended state, waiting for queue post
+  #if (VERBOSE == 1)
+  Task->State = SUSPENDED;
+  Task->SuspendedType = QUEUE;
+  #endif
+  
+  // Remove current task from the Ready List
+  OSReadyListRemove(currentTask, Task->Priority);
+  
+  // Set timeout overflow
+  Task->TimeToWait = wake_time;
+  
+  if (wake_time != NO_TIMEOUT)
+  {
+    // Put task into delay list
+    IncludeTaskIntoDelayList();
+  }
+}
+
+
+// Verifies why the current task left the queue wait list
+// A released task may find the queue empty, because a reader of many elements
+// or a task that was already running took the elements first. In that case
+// the caller waits again, until the same wake time.
+// Returns TIMEOUT if the time to wait has elapsed since start and the queue is empty, or OK
+static INT8U OSDQueueResume(BRTOS_Queue *pont_event, OS_DQUEUE *cqueue, TickType start, TickType time_wait)
+{
+  ContextType *Task = (ContextType*)&ContextTask[currentTask];
+  TickType    now;
+  TickType    elapsed;
+  
+  if (time_wait)
+  {
+    // Verify if the reason of task wake up was queue timeout
+    if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+    {
+      // Test if both timeout and post have occured before arrive here
+      if (OSWaitListTest(pont_event->OSEventWaitList, currentTask, Task->Priority))
+      {
+        // Remove the task from the queue wait list
+        OSWaitListRemove(pont_event->OSEventWaitList, currentTask, Task->Priority);
+        
+        // Decreases the queue wait list counter
+        pont_event->OSEventWait--;
+      }
+      
+      if (cqueue->OSQEntries == 0)
+      {
+        // Indicates queue timeout
+        return TIMEOUT;
+      }
+    }
+    else
+    {
+      // Remove the time to wait condition
+      Task->TimeToWait = NO_TIMEOUT;
+      
+      // Remove from delay list
+      RemoveFromDelayList();
+      
+      // A task that runs late may find its wake time already passed,
+      // and waiting again would only end after a full tick count overflow
+      now = OSGetCount();
+      if (now >= start)
+      {
+        elapsed = (TickType)(now - start);
+      }
+      else
+      {
+        elapsed = (TickType)(TICK_COUNT_OVERFLOW - start + now);
+      }
+      
+      if ((cqueue->OSQEntries == 0) && (elapsed >= time_wait))
+      {
+        // Indicates queue timeout
+        return TIMEOUT;
+      }
+    }
+  }
+  
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Create Dynamic Queue Function               /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDQueueCreate(INT16U queue_length, OS_CPU_TYPE type_size, BRTOS_Queue **event)
+{
+  OS_SR_SAVE_VAR
+  #if (BRTOS_OBJECT_POOL_EN == 0)
+  INT16S      i             = 0;
+  #endif
+  INT16U      size_in_bytes = 0;
   BRTOS_Queue *pont_event   = NULL;
   OS_DQUEUE   *cqueue       = NULL;
 
@@ -1163,17 +1791,33 @@ INT8U OSDQueueCreate(INT16U queue_length, OS_CPU_TYPE type_size, BRTOS_Queue **e
 	if((queue_length > 0) && (type_size > 0))
 	{
 		// Allocate the queue handler
-		cqueue = (OS_DQUEUE*)BRTOS_ALLOC(sizeof(OS_DQUEUE));
+		cqueue = (OS_DQUEUE*)DQUEUE_ALLOC(sizeof(OS_DQUEUE));
 		if( cqueue != NULL )
 		{
 			// Calculate the queue size in bytes
 			size_in_bytes = (INT16U)(queue_length * type_size);
 
 			// Allocate the queue in the heap
-			cqueue->OSQStart = (INT8U*)BRTOS_ALLOC(size_in_bytes);
+			cqueue->OSQStart = (INT8U*)DQUEUE_ALLOC(size_in_bytes);
 			
 			if(cqueue->OSQStart != NULL)
 			{  
+        #if (BRTOS_OBJECT_POOL_EN == 1)
+        // Takes a control block from the shared object pool
+        pont_event = (BRTOS_Queue*)OSObjectAlloc(OBJECT_QUEUE);
+        if (pont_event == NULL)
+        {
+          // If there is not, deallocate data and return exception
+          DQUEUE_DEALLOC(cqueue->OSQStart);
+          DQUEUE_DEALLOC(cqueue);
+
+          // Exit critical Section
+          if (currentTask)
+             OSExitCritical();
+
+          return(NO_AVAILABLE_EVENT);
+        }
+        #else
         // Verifies if there is available event control block
         for(i=0;i<=BRTOS_MAX_QUEUE;i++)
         {
@@ -1181,8 +1825,8 @@ INT8U OSDQueueCreate(INT16U queue_length, OS_CPU_TYPE type_size, BRTOS_Queue **e
           if(i >= BRTOS_MAX_QUEUE)
           {
             // If there is not, deallocate data and return exception
-            BRTOS_DEALLOC(cqueue->OSQStart);
-            BRTOS_DEALLOC(cqueue);
+            DQUEUE_DEALLOC(cqueue->OSQStart);
+            DQUEUE_DEALLOC(cqueue);
             
             // Exit critical Section
             if (currentTask)
@@ -1199,10 +1843,11 @@ INT8U OSDQueueCreate(INT16U queue_length, OS_CPU_TYPE type_size, BRTOS_Queue **e
             break;      
           }
         }			
+        #endif
 			}else 
 			{
         // Deallocate queue handler
-        BRTOS_DEALLOC(cqueue);
+        DQUEUE_DEALLOC(cqueue);
         
         // Exit critical Section
         if (currentTask)
@@ -1236,13 +1881,25 @@ INT8U OSDQueueCreate(INT16U queue_length, OS_CPU_TYPE type_size, BRTOS_Queue **e
   cqueue->OSQEnd     = cqueue->OSQStart + size_in_bytes;
   cqueue->OSQIn      = cqueue->OSQStart;
   cqueue->OSQOut     = cqueue->OSQStart;
+  #if (BRTOS_DQUEUE_SLOT_EN == 1)
+  cqueue->OSQReserved = FALSE;
+  cqueue->OSQPeeked   = FALSE;
+  #endif
   
   // Aloca tipo de evento e dados do evento
   pont_event->OSEventPointer = cqueue;
   pont_event->OSEventWait = 0;
   
   
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
+  #if (BRTOS_SET_EN == 1)
+  pont_event->OSEventSet = NULL;
+  #endif
+  #if (BRTOS_POST_WAIT_EN == 1)
+  pont_event->OSEventSendWait     = 0;
+  pont_event->OSEventSendReserved = 0;
+  PrioListInit(pont_event->OSEventSendWaitList);
+  #endif
   
   *event = pont_event;
   
@@ -1281,14 +1938,41 @@ INT8U OSDQueueDelete (BRTOS_Queue **event)
   // Enter Critical Section
   OSEnterCritical();
   
-  BRTOS_DEALLOC(cqueue->OSQStart);
-  BRTOS_DEALLOC(cqueue);
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+  
+  #if (BRTOS_SET_EN == 1)
+  // The object leaves its event set before the control block is released
+  if (pont_event->OSEventSet != NULL)
+  {
+    (void)OSSetUnlink(pont_event->OSEventSet, pont_event);
+  }
+  #endif
+  
+  DQUEUE_DEALLOC(cqueue->OSQStart);
+  DQUEUE_DEALLOC(cqueue);
     
   pont_event->OSEventAllocated = 0;
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Gives the control block back to the shared object pool
+  OSObjectFree(pont_event);
+  #endif
   pont_event->OSEventCount     = 0;                      
   pont_event->OSEventWait      = 0;
   
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
+  #if (BRTOS_POST_WAIT_EN == 1)
+  pont_event->OSEventSendWait     = 0;
+  pont_event->OSEventSendReserved = 0;
+  PrioListInit(pont_event->OSEventSendWaitList);
+  #endif
   
   *event = NULL;
   
@@ -1328,6 +2012,23 @@ INT8U OSDQueueClean(BRTOS_Queue *pont_event)
   cqueue->OSQIn       = cqueue->OSQStart;
   cqueue->OSQOut      = cqueue->OSQStart;
   
+  #if (BRTOS_DQUEUE_SLOT_EN == 1)
+  // The reserved and peeked slots are discarded
+  cqueue->OSQReserved = FALSE;
+  cqueue->OSQPeeked   = FALSE;
+  #endif
+  
+  #if (BRTOS_POST_WAIT_EN == 1)
+  // Release the tasks waiting for space in the queue
+  if (OSQueueSendWakeup(pont_event, OSDQueueFree(pont_event, cqueue)))
+  {
+    if (!iNesting)
+    {
+      ChangeContext();
+    }
+  }
+  #endif
+  
   // Exit Critical Section
   #if (NESTING_INT == 0)
   if (!iNesting)
@@ -1352,15 +2053,13 @@ INT8U OSDQueueClean(BRTOS_Queue *pont_event)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U OSDQueuePend (BRTOS_Queue *pont_event, void *pdata, INT16U time_wait)
+INT8U OSDQueuePend (BRTOS_Queue *pont_event, void *pdata, TickType time_wait)
 {
   OS_SR_SAVE_VAR
-  INT8U       iPriority = 0;
-  INT32U      timeout;
-  INT16U      n;  
-  ContextType *Task;
+  INT8U       woken = FALSE;
+  TickType    wake_time = NO_TIMEOUT;
+  TickType    start = 0;
   OS_DQUEUE   *cqueue;
-  INT8U       *dst;  
    
   #if (ERROR_CHECK == 1)
     /// Can not use Queue pend function from interrupt handling code
@@ -1375,16 +2074,22 @@ INT8U OSDQueuePend (BRTOS_Queue *pont_event, void *pdata, INT16U time_wait)
       return(NULL_EVENT_POINTER);
     }
   #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
     
   // Enter Critical Section
   OSEnterCritical();
   cqueue  = pont_event->OSEventPointer;
-  n       = cqueue->OSQTSize;
-  dst     = (INT8U*)pdata;
 
   #if (ERROR_CHECK == 1)
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
     {
       // Exit Critical Section
       OSExitCritical();
@@ -1401,139 +2106,72 @@ INT8U OSDQueuePend (BRTOS_Queue *pont_event, void *pdata, INT16U time_wait)
       #endif
   #endif   
     
-  // Verify if there is data in the queue
-  if(cqueue->OSQEntries > 0)
+  if (time_wait)
   {
-    // Verify for output pointer overflow
-    if (cqueue->OSQOut == cqueue->OSQEnd)
-      cqueue->OSQOut = cqueue->OSQStart;
-  
-    // Copy data from queue
-    while(n) 
-    {
-      // copy data and increase the input pointer
-      *dst++ = *cqueue->OSQOut++;
-      n--;
-    }
-    
-    // Decreases queue entries
-    cqueue->OSQEntries--;
-    
-    // Exit Critical Section
-    OSExitCritical();
-    return READ_BUFFER_OK;
+    start = OSGetCount();
+    wake_time = OSWakeTimeCompute(time_wait);
   }
-  else
-  {
-    Task = (ContextType*)&ContextTask[currentTask];
-    
-    // Copy task priority to local scope
-    iPriority = Task->Priority;
-  
-    // Increases the queue wait list counter
-    pont_event->OSEventWait++;
-    
-    // Allocates the current task on the queue wait list
-    pont_event->OSEventWaitList = pont_event->OSEventWaitList | (PriorityMask[iPriority]);
   
-    // Task entered suspended state, waiting for queue post
-    #if (VERBOSE == 1)
-    Task->State = SUSPENDED;
-    Task->SuspendedType = QUEUE;
-    #endif
-
-    // Remove current task from the Ready List
-    OSReadyList = OSReadyList & ~(PriorityMask[iPriority]);
-  
-    // Set timeout overflow
-    if (time_wait)
-    {  
-      timeout = (INT32U)((INT32U)OSGetCount() + (INT32U)time_wait);
-      
-      if (timeout >= TICK_COUNT_OVERFLOW)
-      {
-        Task->TimeToWait = (INT16U)(timeout - TICK_COUNT_OVERFLOW);
-      }
-      else
-      {
-        Task->TimeToWait = (INT16U)timeout;
-      }
+  // Wait while the queue is empty
+  while(cqueue->OSQEntries == 0)
+  {
+    OSDQueueSuspend(pont_event, wake_time);
     
-      // Put task into delay list
-      IncludeTaskIntoDelayList();
-    } else
-    {
-      Task->TimeToWait = NO_TIMEOUT;
-    }
-  
     // Change Context - Returns on time overflow or queue post
     ChangeContext();
     
     // Exit Critical Section
     OSExitCritical();
     // Enter Critical Section
-    OSEnterCritical();  
-    
-    if (time_wait)
-    {    
-        // Verify if the reason of task wake up was queue timeout
-        if(Task->TimeToWait == EXIT_BY_TIMEOUT)
-        {
-            // Test if both timeout and post have occured before arrive here
-            if ((pont_event->OSEventWaitList & PriorityMask[iPriority]))
-            {
-              // Remove the task from the queue wait list
-              pont_event->OSEventWaitList = pont_event->OSEventWaitList & ~(PriorityMask[iPriority]);
-              
-              // Decreases the queue wait list counter
-              pont_event->OSEventWait--;
-              
-              // Exit Critical Section
-              OSExitCritical();
-              
-              // Indicates queue timeout
-              return TIMEOUT;
-            }
-        }
-        else
-        {
-            // Remove the time to wait condition
-            Task->TimeToWait = NO_TIMEOUT;
-            
-            // Remove from delay list
-            RemoveFromDelayList();
-        }
-       
-    }
+    OSEnterCritical();
     
-    // Verify for output pointer overflow
-    if (cqueue->OSQOut == cqueue->OSQEnd)
-      cqueue->OSQOut = cqueue->OSQStart;
-  
-    // Copy data from queue
-    while(n) 
+    if (OSDQueueResume(pont_event, cqueue, start, time_wait) == TIMEOUT)
     {
-      // copy data and increase the input pointer
-      *dst++ = *cqueue->OSQOut++;
-      n--;
+      // Exit Critical Section
+      OSExitCritical();
+      
+      // Indicates queue timeout
+      return TIMEOUT;
     }
-    
-    // Decreases queue entries
-    cqueue->OSQEntries--;
-    
-    // Exit Critical Section
-    OSExitCritical();
-    return READ_BUFFER_OK;
   }
-}
-
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////
-
-
-
+  
+  // Copy data from queue
+  OSDQueueRead(cqueue, (INT8U*)pdata);
+  
+  // Decreases queue entries
+  cqueue->OSQEntries--;
+  
+  // The remaining elements release the next task waiting for data
+  if ((cqueue->OSQEntries > 0) && OSDQueueWakeup(pont_event, 1))
+  {
+    woken = TRUE;
+  }
+  
+  #if (BRTOS_POST_WAIT_EN == 1)
+  // Release a task waiting for space in the queue
+  if (OSQueueSendWakeup(pont_event, OSDQueueFree(pont_event, cqueue)))
+  {
+    woken = TRUE;
+  }
+  #endif
+  
+  if (woken == TRUE)
+  {
+    ChangeContext();
+  }
+  
+  // Exit Critical Section
+  OSExitCritical();
+  return READ_BUFFER_OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
 
 
 ////////////////////////////////////////////////////////////
@@ -1545,14 +2183,6 @@ INT8U OSDQueuePend (BRTOS_Queue *pont_event, void *pdata, INT16U time_wait)
 INT8U OSDQueuePost(BRTOS_Queue *pont_event, void *pdata)
 {
   OS_SR_SAVE_VAR
-  INT8U iPriority = (INT8U)0;
-  
-  #if (VERBOSE == 1)
-  INT8U TaskSelect = 0;
-  #endif
-  
-  INT16U    n;
-  INT8U     *src;
   OS_DQUEUE *cqueue;
   
   #if (ERROR_CHECK == 1)    
@@ -1570,12 +2200,10 @@ INT8U OSDQueuePost(BRTOS_Queue *pont_event, void *pdata)
      OSEnterCritical();
      
   cqueue  = pont_event->OSEventPointer;
-  src     = (INT8U*)pdata;
-  n       = cqueue->OSQTSize;
 
   #if (ERROR_CHECK == 1)        
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
     {
       // Exit Critical Section
       #if (NESTING_INT == 0)
@@ -1600,7 +2228,7 @@ INT8U OSDQueuePost(BRTOS_Queue *pont_event, void *pdata)
   #endif       
   
   // Checks for queue overflow
-  if (cqueue->OSQEntries < cqueue->OSQLength)
+  if (OSDQueueFree(pont_event, cqueue) > 0)
   {  
     // If no, increases the queue entries
     cqueue->OSQEntries++;
@@ -1617,38 +2245,12 @@ INT8U OSDQueuePost(BRTOS_Queue *pont_event, void *pdata)
      return BUFFER_UNDERRUN;
   }
   
-  // Verify for input pointer overflow
-  if (cqueue->OSQIn == cqueue->OSQEnd)
-    cqueue->OSQIn = cqueue->OSQStart;
-  
   // copy data into the queue
-  while(n) 
-  {
-    // copy data and increase the input pointer
-    *cqueue->OSQIn++ = *src++;
-    n--;
-  } 
+  OSDQueueWrite(cqueue, (INT8U*)pdata);
   
   // See if any task is waiting for new data in the queue
-  if (pont_event->OSEventWait != 0)
+  if (OSDQueueWakeup(pont_event, 1))
   {
-    // Selects the highest priority task
-    iPriority = SAScheduler(pont_event->OSEventWaitList);    
-
-    // Remove the selected task from the queue wait list
-    pont_event->OSEventWaitList = pont_event->OSEventWaitList & ~(PriorityMask[iPriority]);
-    
-    // Decreases the queue wait list counter
-    pont_event->OSEventWait--;
-    
-    // Put the selected task into Ready List
-    #if (VERBOSE == 1)
-    TaskSelect = PriorityVector[iPriority];
-    ContextTask[TaskSelect].State = READY;
-    #endif
-    
-    OSReadyList = OSReadyList | (PriorityMask[iPriority]);
-    
     // If outside of an interrupt service routine, change context to the highest priority task
     // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
     if (!iNesting)
@@ -1667,6 +2269,14 @@ INT8U OSDQueuePost(BRTOS_Queue *pont_event, void *pdata)
   }
   else
   {
+    #if (BRTOS_SET_EN == 1)
+    // Signals the set that holds this queue
+    if (OSSetSignal(pont_event->OSEventSet, pont_event) && !iNesting)
+    {
+      ChangeContext();
+    }
+    #endif
+    
     // Exit Critical Section
     #if (NESTING_INT == 0)
     if (!iNesting)
@@ -1683,6 +2293,821 @@ INT8U OSDQueuePost(BRTOS_Queue *pont_event, void *pdata)
 ////////////////////////////////////////////////////////////
 
 
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Dynamic Queue Post Multiple Function        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDQueuePostMulti(BRTOS_Queue *pont_event, void *pdata, INT16U count, INT16U *posted)
+{
+  OS_SR_SAVE_VAR
+  INT16U    i = 0;
+  INT16U    woken;
+  INT8U     *src;
+  OS_DQUEUE *cqueue;
+  
+  #if (ERROR_CHECK == 1)    
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+     
+  cqueue  = pont_event->OSEventPointer;
+  src     = (INT8U*)pdata;
+
+  #if (ERROR_CHECK == 1)        
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+     
+  // BRTOS TRACE SUPPORT
+  #if (OSTRACE == 1)  
+    if(!iNesting){ 
+      #if(OS_TRACE_BY_TASK == 1)
+      Update_OSTrace(currentTask, QUEUEPOST);
+      #else
+      Update_OSTrace(ContextTask[currentTask].Priority, QUEUEPOST);
+      #endif
+    }else{
+      Update_OSTrace(0, QUEUEPOST);
+    }
+  #endif       
+  
+  // Copy the elements while there is space in the queue
+  while ((i < count) && (OSDQueueFree(pont_event, cqueue) > 0))
+  {
+    cqueue->OSQEntries++;
+    OSDQueueWrite(cqueue, src);
+    src += cqueue->OSQTSize;
+    i++;
+  }
+  
+  if (posted != NULL)
+  {
+    *posted = i;
+  }
+  
+  // Release only the highest priority waiting task, since a reader of many
+  // elements may take all of them. Each reader releases the next waiting task
+  // while there are elements left in the queue.
+  woken = OSDQueueWakeup(pont_event, (INT16U)((i > 0) ? 1 : 0));
+  
+  #if (BRTOS_SET_EN == 1)
+  // The elements not taken by the released tasks signal the set that holds this queue
+  if (woken < i)
+  {
+    woken = (INT16U)(woken + OSSetSignal(pont_event->OSEventSet, pont_event));
+  }
+  #endif
+  
+  if (woken)
+  {
+    // If outside of an interrupt service routine, change context to the highest priority task
+    // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+    if (!iNesting)
+    {
+      // Verify if there is a higher priority task ready to run
+      ChangeContext();      
+    }
+  }
+  
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+  
+  if (i < count)
+  {
+    // Indicates queue overflow
+    return BUFFER_UNDERRUN;
+  }
+  
+  return WRITE_BUFFER_OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Dynamic Queue Pend Multiple Function        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDQueuePendMulti(BRTOS_Queue *pont_event, void *pdata, INT16U count, INT16U *received, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U       woken = FALSE;
+  INT16U      i = 0;
+  TickType    wake_time = NO_TIMEOUT;
+  TickType    start = 0;
+  OS_DQUEUE   *cqueue;
+  INT8U       *dst;  
+   
+  #if (ERROR_CHECK == 1)
+    /// Can not use Queue pend function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+    
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+  
+  if (received != NULL)
+  {
+    *received = 0;
+  }
+  
+  if (count == 0)
+  {
+    return(INVALID_PARAMETERS);
+  }
+    
+  // Enter Critical Section
+  OSEnterCritical();
+  cqueue  = pont_event->OSEventPointer;
+  dst     = (INT8U*)pdata;
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+  
+  // BRTOS TRACE SUPPORT
+  #if (OSTRACE == 1) 
+      #if(OS_TRACE_BY_TASK == 1)
+      Update_OSTrace(currentTask, QUEUEPEND);
+      #else
+      Update_OSTrace(ContextTask[currentTask].Priority, QUEUEPEND);
+      #endif
+  #endif   
+    
+  if (time_wait)
+  {
+    start = OSGetCount();
+    wake_time = OSWakeTimeCompute(time_wait);
+  }
+  
+  // Wait for the first element while the queue is empty
+  while(cqueue->OSQEntries == 0)
+  {
+    OSDQueueSuspend(pont_event, wake_time);
+    
+    // Change Context - Returns on time overflow or queue post
+    ChangeContext();
+    
+    // Exit Critical Section
+    OSExitCritical();
+    // Enter Critical Section
+    OSEnterCritical();
+    
+    if (OSDQueueResume(pont_event, cqueue, start, time_wait) == TIMEOUT)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      
+      // Indicates queue timeout
+      return TIMEOUT;
+    }
+  }
+  
+  // Copy all the available elements, up to count
+  while ((i < count) && (cqueue->OSQEntries > 0))
+  {
+    OSDQueueRead(cqueue, dst);
+    cqueue->OSQEntries--;
+    dst += cqueue->OSQTSize;
+    i++;
+  }
+  
+  // The remaining elements release the next task waiting for data
+  if ((cqueue->OSQEntries > 0) && OSDQueueWakeup(pont_event, 1))
+  {
+    woken = TRUE;
+  }
+  
+  #if (BRTOS_POST_WAIT_EN == 1)
+  // Release one task waiting for space for each element read
+  if (OSQueueSendWakeup(pont_event, OSDQueueFree(pont_event, cqueue)))
+  {
+    woken = TRUE;
+  }
+  #endif
+  
+  if (woken == TRUE)
+  {
+    ChangeContext();
+  }
+  
+  if (received != NULL)
+  {
+    *received = i;
+  }
+  
+  // Exit Critical Section
+  OSExitCritical();
+  return READ_BUFFER_OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+
+#if (BRTOS_POST_WAIT_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Post Dynamic Queue With Timeout Function    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDQueuePostWait(BRTOS_Queue *pont_event, void *pdata, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  OS_DQUEUE *cqueue;
+  
+  #if (ERROR_CHECK == 1)
+    /// Can not wait for space in the queue from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+    
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+  
+  // Enter Critical Section
+  OSEnterCritical();
+  
+  cqueue = pont_event->OSEventPointer;
+  
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+  
+  // BRTOS TRACE SUPPORT
+  #if (OSTRACE == 1) 
+      #if(OS_TRACE_BY_TASK == 1)
+      Update_OSTrace(currentTask, QUEUEPOST);
+      #else
+      Update_OSTrace(ContextTask[currentTask].Priority, QUEUEPOST);
+      #endif
+  #endif
+  
+  // Verify if the queue is full, including the slots kept to released senders
+  if (OSDQueueFree(pont_event, cqueue) == 0)
+  {
+    OSQueueSendSuspend(pont_event, time_wait);
+    
+    // Change Context - Returns on time overflow or queue pend
+    ChangeContext();
+    
+    // Exit Critical Section
+    OSExitCritical();
+    // Enter Critical Section
+    OSEnterCritical();
+    
+    if (OSQueueSendResume(pont_event, time_wait) == TIMEOUT)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      
+      // Indicates queue timeout
+      return TIMEOUT;
+    }
+  }
+  
+  // Increases the queue entries
+  cqueue->OSQEntries++;
+  
+  // copy data into the queue
+  OSDQueueWrite(cqueue, (INT8U*)pdata);
+  
+  // See if any task is waiting for new data in the queue
+  if (OSDQueueWakeup(pont_event, 1))
+  {
+    // Verify if there is a higher priority task ready to run
+    ChangeContext();
+  }
+  #if (BRTOS_SET_EN == 1)
+  else
+  {
+    // Signals the set that holds this queue
+    if (OSSetSignal(pont_event->OSEventSet, pont_event))
+    {
+      ChangeContext();
+    }
+  }
+  #endif
+  
+  // Exit Critical Section
+  OSExitCritical();
+  
+  return WRITE_BUFFER_OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
+
+
+
+
+#if (BRTOS_DQUEUE_SLOT_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Dynamic Queue Reserve Slot Function         /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDQueueReserve(BRTOS_Queue *pont_event, void **slot)
+{
+  OS_SR_SAVE_VAR
+  OS_DQUEUE *cqueue;
+  
+  #if (ERROR_CHECK == 1)    
+    // Verifies if the pointer is NULL
+    if((pont_event == NULL) || (slot == NULL))
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+     
+  cqueue  = pont_event->OSEventPointer;
+
+  #if (ERROR_CHECK == 1)        
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+  
+  // Only one slot may be reserved, and not before the released senders write their data
+  if (cqueue->OSQReserved || (QUEUE_SEND_RESERVED(pont_event) != 0))
+  {
+    // Exit Critical Section
+    #if (NESTING_INT == 0)
+    if (!iNesting)
+    #endif
+       OSExitCritical();
+    return BUSY_RESOURCE;
+  }
+  
+  // Checks for queue overflow
+  if (OSDQueueFree(pont_event, cqueue) == 0)
+  {
+    // Exit Critical Section
+    #if (NESTING_INT == 0)
+    if (!iNesting)
+    #endif
+       OSExitCritical();
+    
+    // Indicates queue overflow
+    return BUFFER_UNDERRUN;
+  }
+  
+  // Verify for input pointer overflow
+  if (cqueue->OSQIn == cqueue->OSQEnd)
+    cqueue->OSQIn = cqueue->OSQStart;
+  
+  // The input slot is written in place by the caller
+  *slot = cqueue->OSQIn;
+  cqueue->OSQReserved = TRUE;
+  
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+  
+  return WRITE_BUFFER_OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Dynamic Queue Commit Slot Function          /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDQueueCommit(BRTOS_Queue *pont_event)
+{
+  OS_SR_SAVE_VAR
+  OS_DQUEUE *cqueue;
+  INT8U     woken = FALSE;
+  
+  #if (ERROR_CHECK == 1)    
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+     
+  cqueue  = pont_event->OSEventPointer;
+
+  #if (ERROR_CHECK == 1)        
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+  
+  // Verify if there is a reserved slot
+  if (cqueue->OSQReserved != TRUE)
+  {
+    // Exit Critical Section
+    #if (NESTING_INT == 0)
+    if (!iNesting)
+    #endif
+       OSExitCritical();
+    return INVALID_PARAMETERS;
+  }
+  
+  // Publish the reserved slot
+  cqueue->OSQReserved = FALSE;
+  cqueue->OSQIn += cqueue->OSQTSize;
+  cqueue->OSQEntries++;
+  
+  // See if any task is waiting for new data in the queue
+  if (OSDQueueWakeup(pont_event, 1))
+  {
+    woken = TRUE;
+  }
+  #if (BRTOS_SET_EN == 1)
+  else
+  {
+    // Signals the set that holds this queue
+    woken = OSSetSignal(pont_event->OSEventSet, pont_event);
+  }
+  #endif
+  
+  #if (BRTOS_POST_WAIT_EN == 1)
+  // Release the tasks waiting for space in the queue
+  if (OSQueueSendWakeup(pont_event, OSDQueueFree(pont_event, cqueue)))
+  {
+    woken = TRUE;
+  }
+  #endif
+  
+  // If outside of an interrupt service routine, change context to the highest priority task
+  // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+  if (woken && !iNesting)
+  {
+    // Verify if there is a higher priority task ready to run
+    ChangeContext();
+  }
+  
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+  
+  return WRITE_BUFFER_OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Dynamic Queue Peek Slot Function            /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDQueuePeekSlot(BRTOS_Queue *pont_event, void **slot, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  TickType    wake_time = NO_TIMEOUT;
+  TickType    start = 0;
+  OS_DQUEUE   *cqueue;
+   
+  #if (ERROR_CHECK == 1)
+    /// Can not use Queue pend function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+    
+    // Verifies if the pointer is NULL
+    if((pont_event == NULL) || (slot == NULL))
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+    
+  // Enter Critical Section
+  OSEnterCritical();
+  cqueue  = pont_event->OSEventPointer;
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+  
+  // Only one slot may be peeked
+  if (cqueue->OSQPeeked)
+  {
+    // Exit Critical Section
+    OSExitCritical();
+    return BUSY_RESOURCE;
+  }
+  
+  // BRTOS TRACE SUPPORT
+  #if (OSTRACE == 1) 
+      #if(OS_TRACE_BY_TASK == 1)
+      Update_OSTrace(currentTask, QUEUEPEND);
+      #else
+      Update_OSTrace(ContextTask[currentTask].Priority, QUEUEPEND);
+      #endif
+  #endif   
+    
+  if (time_wait)
+  {
+    start = OSGetCount();
+    wake_time = OSWakeTimeCompute(time_wait);
+  }
+  
+  // Wait while the queue is empty
+  while(cqueue->OSQEntries == 0)
+  {
+    OSDQueueSuspend(pont_event, wake_time);
+    
+    // Change Context - Returns on time overflow or queue post
+    ChangeContext();
+    
+    // Exit Critical Section
+    OSExitCritical();
+    // Enter Critical Section
+    OSEnterCritical();
+    
+    if (OSDQueueResume(pont_event, cqueue, start, time_wait) == TIMEOUT)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      
+      // Indicates queue timeout
+      return TIMEOUT;
+    }
+  }
+  
+  // Another consumer may have peeked a slot while this task was waiting
+  if (cqueue->OSQPeeked)
+  {
+    // The element is left to the next task waiting for data
+    if (OSDQueueWakeup(pont_event, 1))
+    {
+      ChangeContext();
+    }
+    
+    // Exit Critical Section
+    OSExitCritical();
+    return BUSY_RESOURCE;
+  }
+  
+  // Verify for output pointer overflow
+  if (cqueue->OSQOut == cqueue->OSQEnd)
+    cqueue->OSQOut = cqueue->OSQStart;
+  
+  // The element leaves the queue, but its slot is kept until the release
+  *slot = cqueue->OSQOut;
+  cqueue->OSQOut += cqueue->OSQTSize;
+  cqueue->OSQEntries--;
+  cqueue->OSQPeeked = TRUE;
+  
+  // The remaining elements release the next task waiting for data
+  if ((cqueue->OSQEntries > 0) && OSDQueueWakeup(pont_event, 1))
+  {
+    ChangeContext();
+  }
+  
+  // Exit Critical Section
+  OSExitCritical();
+  return READ_BUFFER_OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Dynamic Queue Release Slot Function         /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSDQueueRelease(BRTOS_Queue *pont_event)
+{
+  OS_SR_SAVE_VAR
+  OS_DQUEUE *cqueue;
+  #if (BRTOS_POST_WAIT_EN == 1)
+  INT8U     woken = FALSE;
+  #endif
+  
+  #if (ERROR_CHECK == 1)    
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+     
+  cqueue  = pont_event->OSEventPointer;
+
+  #if (ERROR_CHECK == 1)        
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_QUEUE))
+    {
+      // Exit Critical Section
+      #if (NESTING_INT == 0)
+      if (!iNesting)
+      #endif
+         OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+  
+  // Verify if there is a peeked slot
+  if (cqueue->OSQPeeked != TRUE)
+  {
+    // Exit Critical Section
+    #if (NESTING_INT == 0)
+    if (!iNesting)
+    #endif
+       OSExitCritical();
+    return INVALID_PARAMETERS;
+  }
+  
+  // The slot can be used again by the producers
+  cqueue->OSQPeeked = FALSE;
+  
+  #if (BRTOS_POST_WAIT_EN == 1)
+  // Release the tasks waiting for space in the queue
+  if (OSQueueSendWakeup(pont_event, OSDQueueFree(pont_event, cqueue)))
+  {
+    woken = TRUE;
+  }
+  #endif
+  
+  #if (BRTOS_POST_WAIT_EN == 1)
+  // If outside of an interrupt service routine, change context to the highest priority task
+  // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+  if (woken && !iNesting)
+  {
+    // Verify if there is a higher priority task ready to run
+    ChangeContext();
+  }
+  #endif
+  
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+  
+  return READ_BUFFER_OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
 #endif
 
 
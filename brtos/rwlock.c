@@ -0,0 +1,703 @@
+/**
+* \file rwlock.c
+* \brief BRTOS Reader-Writer Lock functions
+*
+* Functions to install and use reader-writer locks
+*
+**/
+/*********************************************************************************************************
+*                                               BRTOS
+*                                Brazilian Real-Time Operating System
+*                            Acronymous of Basic Real-Time Operating System
+*
+*
+*                                  Open Source RTOS under MIT License
+*
+*
+*
+*                                   OS Reader-Writer Lock functions
+*
+*
+*   Revision: 1.80
+*   Date:     17/10/2026
+*
+*  Many readers or one writer hold the lock. A waiting writer blocks the new
+*  readers (writer preference). While a task waits for the lock, one of the
+*  tasks that hold it runs with the lock priority ceiling, as the mutex owner
+*  does, so a medium priority task can not delay the waiting writer.
+*
+*********************************************************************************************************/
+
+#include "BRTOS.h"
+
+#if (PROCESSOR == COLDFIRE_V1)
+#pragma warn_implicitconv off
+#endif
+
+#if (BRTOS_RWLOCK_EN == 1)
+
+#define RWLOCK_READER_WORD(task)    (((task) - 1) >> 5)
+#define RWLOCK_READER_BIT(task)     ((INT32U)1 << (((task) - 1) & 0x1F))
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Reader-Writer Lock Internal Functions       /////
+/////                                                  /////
+/////  Must be called inside a critical section        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Gives the priority ceiling to a task that holds the lock while other tasks
+// wait for it. The priority of a task waiting for other event can only
+// change when it is ready to run, so the scheduler calls it again later.
+static void OSRWLockBoost(BRTOS_RWLock *pont_event)
+{
+  INT8U task;
+  INT8U iPriority;
+  INT8U Ceiling = pont_event->OSMaxPriority;
+  INT8U Selected = 0;
+  INT8U Blocked = FALSE;
+
+  // Give back the priority ceiling
+  task = pont_event->OSRWBoostTask;
+  if (task != 0)
+  {
+    iPriority = ContextTask[task].Priority;
+
+    // The priority may have been changed by a mutex acquired after the lock
+    if (iPriority == Ceiling)
+    {
+      if (!OSReadyListTest(task, iPriority))
+      {
+        OSRWLockBoostPending = TRUE;
+        return;
+      }
+
+      OSReadyListMove(task, Ceiling, pont_event->OSRWBoostOriginal);
+      ContextTask[task].Priority = pont_event->OSRWBoostOriginal;
+    }
+
+    PriorityVector[Ceiling] = MUTEX_PRIO;
+    pont_event->OSRWBoostTask = 0;
+  }
+
+  if ((pont_event->OSRWReadWait == 0) && (pont_event->OSRWWriteWait == 0))
+  {
+    return;
+  }
+
+  // Select the writer or the highest priority reader ready to run
+  if (pont_event->OSRWWriter != 0)
+  {
+    Selected = pont_event->OSRWWriter;
+  }
+  else
+  {
+    for (task = 1; task <= NUMBER_OF_TASKS; task++)
+    {
+      if (pont_event->OSRWReadTasks[RWLOCK_READER_WORD(task)] & RWLOCK_READER_BIT(task))
+      {
+        iPriority = ContextTask[task].Priority;
+        if (!OSReadyListTest(task, iPriority))
+        {
+          Blocked = TRUE;
+        }
+        else if ((Selected == 0) || (iPriority > ContextTask[Selected].Priority))
+        {
+          Selected = task;
+        }
+      }
+    }
+  }
+
+  if (Selected == 0)
+  {
+    // The readers that hold the lock are waiting for other events
+    if (Blocked == TRUE)
+    {
+      OSRWLockBoostPending = TRUE;
+    }
+    return;
+  }
+
+  iPriority = ContextTask[Selected].Priority;
+  if (iPriority >= Ceiling)
+  {
+    return;
+  }
+  
+  // The writer is waiting for other event
+  if (!OSReadyListTest(Selected, iPriority))
+  {
+    OSRWLockBoostPending = TRUE;
+    return;
+  }
+
+  // Receives the priority ceiling temporarily
+  pont_event->OSRWBoostTask = Selected;
+  pont_event->OSRWBoostOriginal = iPriority;
+  PriorityVector[Ceiling] = Selected;
+
+  OSReadyListMove(Selected, iPriority, Ceiling);
+  ContextTask[Selected].Priority = Ceiling;
+}
+
+
+// Gives the priority ceiling to the lock holders that were waiting for other events
+void OSRWLockUpdate(void)
+{
+  INT8U i;
+  BRTOS_RWLock *rwlock;
+
+  // Holders still waiting for other events set it again
+  OSRWLockBoostPending = FALSE;
+
+  for (i = 0; i < BRTOS_MAX_RWLOCK; i++)
+  {
+    rwlock = &BRTOS_RWLock_Table[i];
+    if ((rwlock->OSEventAllocated == TRUE) &&
+        ((rwlock->OSRWReadWait != 0) || (rwlock->OSRWWriteWait != 0) || (rwlock->OSRWBoostTask != 0)))
+    {
+      OSRWLockBoost(rwlock);
+    }
+  }
+}
+
+
+// Gives the free lock to the highest priority waiting writer or,
+// if no writer is waiting, to all the waiting readers
+static void OSRWLockGrant(BRTOS_RWLock *pont_event)
+{
+  INT8U iPriority;
+  INT8U TaskSelect;
+
+  if (pont_event->OSRWWriter != 0)
+  {
+    return;
+  }
+
+  if (pont_event->OSRWWriteWait != 0)
+  {
+    if (pont_event->OSRWReaders != 0)
+    {
+      return;
+    }
+
+    iPriority = PrioListHighest(pont_event->OSRWWriteWaitList);
+    TaskSelect = OSWaitListTask(pont_event->OSRWWriteWaitList, iPriority);
+    OSWaitListRemove(pont_event->OSRWWriteWaitList, TaskSelect, iPriority);
+    pont_event->OSRWWriteWait--;
+
+    pont_event->OSRWWriter = TaskSelect;
+
+    #if (VERBOSE == 1)
+    ContextTask[TaskSelect].State = READY;
+    #endif
+
+    OSReadyListAdd(TaskSelect, iPriority);
+    return;
+  }
+
+  while (pont_event->OSRWReadWait != 0)
+  {
+    iPriority = PrioListHighest(pont_event->OSRWReadWaitList);
+    TaskSelect = OSWaitListTask(pont_event->OSRWReadWaitList, iPriority);
+    OSWaitListRemove(pont_event->OSRWReadWaitList, TaskSelect, iPriority);
+    pont_event->OSRWReadWait--;
+
+    pont_event->OSRWReaders++;
+    pont_event->OSRWReadTasks[RWLOCK_READER_WORD(TaskSelect)] |= RWLOCK_READER_BIT(TaskSelect);
+
+    #if (VERBOSE == 1)
+    ContextTask[TaskSelect].State = READY;
+    #endif
+
+    OSReadyListAdd(TaskSelect, iPriority);
+  }
+}
+
+
+// Suspends the current task on a lock wait list
+static void OSRWLockSuspend(BRTOS_RWLock *pont_event, INT8U *wait, PriorityType *list, TickType time_wait)
+{
+  ContextType *Task = (ContextType*)&ContextTask[currentTask];
+
+  // Increases the wait list counter
+  (*wait)++;
+
+  // Allocates the current task on the wait list
+  OSWaitListAdd(*list, currentTask, Task->Priority);
+
+  // Task entered suspended state, waiting for the lock release
+  #if (VERBOSE == 1)
+  Task->State = SUSPENDED;
+  Task->SuspendedType = RWLOCK;
+  #endif
+
+  // Remove current task from the Ready List
+  OSReadyListRemove(currentTask, Task->Priority);
+
+  // A task that holds the lock receives the priority ceiling
+  OSRWLockBoost(pont_event);
+
+  // Set timeout overflow
+  if (time_wait)
+  {
+    Task->TimeToWait = OSWakeTimeCompute(time_wait);
+
+    // Put task into delay list
+    IncludeTaskIntoDelayList();
+  } else
+  {
+    Task->TimeToWait = NO_TIMEOUT;
+  }
+}
+
+
+// Verifies why the current task left the lock wait list
+// Returns OK when the lock was given to the task, or TIMEOUT
+static INT8U OSRWLockResume(BRTOS_RWLock *pont_event, INT8U *wait, PriorityType *list, TickType time_wait)
+{
+  ContextType *Task = (ContextType*)&ContextTask[currentTask];
+
+  if (time_wait)
+  {
+    // Verify if the reason of task wake up was timeout
+    if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+    {
+      // Test if both timeout and lock release have occured before arrive here
+      if (OSWaitListTest(*list, currentTask, Task->Priority))
+      {
+        // Remove the task from the wait list
+        OSWaitListRemove(*list, currentTask, Task->Priority);
+
+        // Decreases the wait list counter
+        (*wait)--;
+
+        // A writer that gives up may release the readers blocked by it
+        OSRWLockGrant(pont_event);
+        OSRWLockBoost(pont_event);
+        ChangeContext();
+
+        // Indicates timeout
+        return TIMEOUT;
+      }
+    }
+    else
+    {
+      // Remove the time to wait condition
+      Task->TimeToWait = NO_TIMEOUT;
+
+      // Remove from delay list
+      RemoveFromDelayList();
+    }
+  }
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Create Reader-Writer Lock Function          /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSRWLockCreate (BRTOS_RWLock **event, INT8U HigherPriority)
+{
+  OS_SR_SAVE_VAR
+  int i=0;
+
+  BRTOS_RWLock *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be create by interrupt
+  }
+
+  // Enter critical Section
+  if (currentTask)
+     OSEnterCritical();
+
+  if (PriorityVector[HigherPriority] != EMPTY_PRIO)
+  {
+      // Exit critical Section
+      if (currentTask)
+        OSExitCritical();
+      return BUSY_PRIORITY;                          // The priority is busy
+  }
+
+  // Verifies if there is available event control block
+  for(i=0;i<=BRTOS_MAX_RWLOCK;i++)
+  {
+
+    if(i >= BRTOS_MAX_RWLOCK)
+    {
+      // Exit critical Section
+      if (currentTask)
+         OSExitCritical();
+
+      return(NO_AVAILABLE_EVENT);
+    }
+
+    if(BRTOS_RWLock_Table[i].OSEventAllocated != TRUE)
+    {
+      BRTOS_RWLock_Table[i].OSEventAllocated = TRUE;
+      pont_event = &BRTOS_RWLock_Table[i];
+      break;
+    }
+  }
+
+  // Allocate priority to the lock
+  PriorityVector[HigherPriority] = MUTEX_PRIO;
+
+  pont_event->OSMaxPriority  = HigherPriority;
+  pont_event->OSRWWriter     = 0;
+  pont_event->OSRWReaders    = 0;
+  pont_event->OSRWReadWait   = 0;
+  pont_event->OSRWWriteWait  = 0;
+  pont_event->OSRWBoostTask  = 0;
+
+  for(i=0;i<TASK_ALLOC_WORDS;i++)
+  {
+    pont_event->OSRWReadTasks[i] = 0;
+  }
+
+  PrioListInit(pont_event->OSRWReadWaitList);
+  PrioListInit(pont_event->OSRWWriteWaitList);
+
+  *event = pont_event;
+
+  // Exit critical Section
+  if (currentTask)
+     OSExitCritical();
+
+  return(ALLOC_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Delete Reader-Writer Lock Function          /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSRWLockDelete (BRTOS_RWLock **event)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_RWLock *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be delete by interrupt
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  pont_event = *event;
+
+  // The priority ceiling can be used by a task again
+  if (pont_event->OSRWBoostTask == 0)
+  {
+    PriorityVector[pont_event->OSMaxPriority] = EMPTY_PRIO;
+  }
+
+  pont_event->OSEventAllocated = 0;
+  pont_event->OSRWWriter       = 0;
+  pont_event->OSRWReaders      = 0;
+  pont_event->OSRWReadWait     = 0;
+  pont_event->OSRWWriteWait    = 0;
+
+  PrioListInit(pont_event->OSRWReadWaitList);
+  PrioListInit(pont_event->OSRWWriteWaitList);
+
+  *event = NULL;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return(DELETE_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Reader-Writer Lock Read Acquire Function    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSRWLockAcquireRead(BRTOS_RWLock *pont_event, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U ret;
+
+  #if (ERROR_CHECK == 1)
+    // Can not use lock acquire function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // The task already holds the lock
+  if ((pont_event->OSRWWriter == currentTask) ||
+      (pont_event->OSRWReadTasks[RWLOCK_READER_WORD(currentTask)] & RWLOCK_READER_BIT(currentTask)))
+  {
+    OSExitCritical();
+    return OK;
+  }
+
+  // New readers wait while a writer holds the lock or waits for it
+  if ((pont_event->OSRWWriter == 0) && (pont_event->OSRWWriteWait == 0))
+  {
+    pont_event->OSRWReaders++;
+    pont_event->OSRWReadTasks[RWLOCK_READER_WORD(currentTask)] |= RWLOCK_READER_BIT(currentTask);
+
+    OSExitCritical();
+    return OK;
+  }
+
+  OSRWLockSuspend(pont_event, &pont_event->OSRWReadWait, &pont_event->OSRWReadWaitList, time_wait);
+
+  // Change Context - Returns on time overflow or lock release
+  ChangeContext();
+
+  // Exit Critical Section
+  OSExitCritical();
+  // Enter Critical Section
+  OSEnterCritical();
+
+  ret = OSRWLockResume(pont_event, &pont_event->OSRWReadWait, &pont_event->OSRWReadWaitList, time_wait);
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return ret;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Reader-Writer Lock Write Acquire Function   /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSRWLockAcquireWrite(BRTOS_RWLock *pont_event, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U ret;
+
+  #if (ERROR_CHECK == 1)
+    // Can not use lock acquire function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // The task already holds the write lock
+  if (pont_event->OSRWWriter == currentTask)
+  {
+    OSExitCritical();
+    return OK;
+  }
+
+  // A reader would wait for itself
+  if (pont_event->OSRWReadTasks[RWLOCK_READER_WORD(currentTask)] & RWLOCK_READER_BIT(currentTask))
+  {
+    OSExitCritical();
+    return BUSY_RESOURCE;
+  }
+
+  if ((pont_event->OSRWWriter == 0) && (pont_event->OSRWReaders == 0))
+  {
+    pont_event->OSRWWriter = currentTask;
+
+    OSExitCritical();
+    return OK;
+  }
+
+  OSRWLockSuspend(pont_event, &pont_event->OSRWWriteWait, &pont_event->OSRWWriteWaitList, time_wait);
+
+  // Change Context - Returns on time overflow or lock release
+  ChangeContext();
+
+  // Exit Critical Section
+  OSExitCritical();
+  // Enter Critical Section
+  OSEnterCritical();
+
+  ret = OSRWLockResume(pont_event, &pont_event->OSRWWriteWait, &pont_event->OSRWWriteWaitList, time_wait);
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return ret;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Reader-Writer Lock Release Function         /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSRWLockRelease(BRTOS_RWLock *pont_event)
+{
+  OS_SR_SAVE_VAR
+
+  #if (ERROR_CHECK == 1)
+    // Can not use lock release function from interrupt handling code
+    if(iNesting > 0)
+    {
+      return(IRQ_PEND_ERR);
+    }
+
+    // Verifies if the pointer is NULL
+    if(pont_event == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  if (pont_event->OSRWWriter == currentTask)
+  {
+    pont_event->OSRWWriter = 0;
+  }
+  else if (pont_event->OSRWReadTasks[RWLOCK_READER_WORD(currentTask)] & RWLOCK_READER_BIT(currentTask))
+  {
+    pont_event->OSRWReadTasks[RWLOCK_READER_WORD(currentTask)] &= ~RWLOCK_READER_BIT(currentTask);
+    pont_event->OSRWReaders--;
+  }
+  else
+  {
+    // The task does not hold the lock
+    OSExitCritical();
+    return ERR_EVENT_OWNER;
+  }
+
+  // Give the lock to the waiting tasks and move the priority ceiling
+  OSRWLockGrant(pont_event);
+  OSRWLockBoost(pont_event);
+
+  // Verify if there is a higher priority task ready to run
+  ChangeContext();
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#endif
@@ -84,7 +84,9 @@
 INT8U OSSemCreate (INT8U cnt, BRTOS_Sem **event)
 {
   OS_SR_SAVE_VAR
+  #if (BRTOS_OBJECT_POOL_EN == 0)
   int i=0;
+  #endif
 
   BRTOS_Sem *pont_event;
 
@@ -96,6 +98,18 @@ INT8U OSSemCreate (INT8U cnt, BRTOS_Sem **event)
   if (currentTask)
      OSEnterCritical();
   
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Takes a control block from the shared object pool
+  pont_event = (BRTOS_Sem*)OSObjectAlloc(OBJECT_SEM);
+  if (pont_event == NULL)
+  {
+    // Exit critical Section
+    if (currentTask)
+       OSExitCritical();
+
+    return(NO_AVAILABLE_EVENT);
+  }
+  #else
   // Verifica se ainda h blocos de controle de eventos disponveis
   for(i=0;i<=BRTOS_MAX_SEM;i++)
   {
@@ -119,6 +133,7 @@ INT8U OSSemCreate (INT8U cnt, BRTOS_Sem **event)
       break;      
     }
   }
+  #endif
   
     // Exit Critical
   pont_event->OSEventCount = cnt;                      // Set semaphore count value
@@ -126,7 +141,10 @@ INT8U OSSemCreate (INT8U cnt, BRTOS_Sem **event)
 #if (BRTOS_BINARY_SEM_EN == 1)
   pont_event->Binary = FALSE;
 #endif
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
+  #if (BRTOS_SET_EN == 1)
+  pont_event->OSEventSet = NULL;
+  #endif
 
   *event = pont_event;
 
@@ -156,7 +174,9 @@ INT8U OSSemCreate (INT8U cnt, BRTOS_Sem **event)
 INT8U OSSemBinaryCreate (INT8U bit, BRTOS_Sem **event)
 {
   OS_SR_SAVE_VAR
+  #if (BRTOS_OBJECT_POOL_EN == 0)
   int i=0;
+  #endif
 
   BRTOS_Sem *pont_event;
 
@@ -168,6 +188,18 @@ INT8U OSSemBinaryCreate (INT8U bit, BRTOS_Sem **event)
   if (currentTask)
      OSEnterCritical();
 
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Takes a control block from the shared object pool
+  pont_event = (BRTOS_Sem*)OSObjectAlloc(OBJECT_SEM);
+  if (pont_event == NULL)
+  {
+    // Exit critical Section
+    if (currentTask)
+       OSExitCritical();
+
+    return(NO_AVAILABLE_EVENT);
+  }
+  #else
   // Verifica se ainda h blocos de controle de eventos disponveis
   for(i=0;i<=BRTOS_MAX_SEM;i++)
   {
@@ -191,6 +223,7 @@ INT8U OSSemBinaryCreate (INT8U bit, BRTOS_Sem **event)
       break;
     }
   }
+  #endif
   
   // Exit Critical
   if (bit > 1)
@@ -202,7 +235,10 @@ INT8U OSSemBinaryCreate (INT8U bit, BRTOS_Sem **event)
   }
   pont_event->OSEventWait  = 0;
   pont_event->Binary = TRUE;
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
+  #if (BRTOS_SET_EN == 1)
+  pont_event->OSEventSet = NULL;
+  #endif
   
   *event = pont_event;
   
@@ -242,11 +278,33 @@ INT8U OSSemDelete (BRTOS_Sem **event)
   OSEnterCritical();
   
   pont_event = *event;  
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the event is allocated
+    if(!OSObjectCreated(pont_event, OBJECT_SEM))
+    {
+      // Exit Critical Section
+      OSExitCritical();
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  #if (BRTOS_SET_EN == 1)
+  // The object leaves its event set before the control block is released
+  if (pont_event->OSEventSet != NULL)
+  {
+    (void)OSSetUnlink(pont_event->OSEventSet, pont_event);
+  }
+  #endif
   pont_event->OSEventAllocated = 0;
+  #if (BRTOS_OBJECT_POOL_EN == 1)
+  // Gives the control block back to the shared object pool
+  OSObjectFree(pont_event);
+  #endif
   pont_event->OSEventCount     = 0;                      
   pont_event->OSEventWait      = 0;
   
-  pont_event->OSEventWaitList=0;
+  PrioListInit(pont_event->OSEventWaitList);
   
   *event = NULL;
   
@@ -271,11 +329,10 @@ INT8U OSSemDelete (BRTOS_Sem **event)
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
-INT8U OSSemPend (BRTOS_Sem *pont_event, INT16U time_wait)
+INT8U OSSemPend (BRTOS_Sem *pont_event, TickType time_wait)
 {
   OS_SR_SAVE_VAR
   INT8U  iPriority = 0;
-  INT32U timeout;
   ContextType *Task;
   
   #if (ERROR_CHECK == 1)
@@ -291,13 +348,21 @@ INT8U OSSemPend (BRTOS_Sem *pont_event, INT16U time_wait)
       return(NULL_EVENT_POINTER);
     }
   #endif
+
+  #if (BRTOS_SCHED_LOCK_EN == 1)
+    // Can not wait while the scheduler is locked
+    if(OSSchedLockNesting > 0)
+    {
+      return(SCHED_LOCK_PEND_ERR);
+    }
+  #endif
     
   // Enter Critical Section
   OSEnterCritical();
 
   #if (ERROR_CHECK == 1)
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_SEM))
     {
       // Exit Critical Section
       OSExitCritical();
@@ -333,7 +398,7 @@ INT8U OSSemPend (BRTOS_Sem *pont_event, INT16U time_wait)
   pont_event->OSEventWait++;
   
   // Allocates the current task on the semaphore wait list
-  pont_event->OSEventWaitList = pont_event->OSEventWaitList | (PriorityMask[iPriority]);
+  OSWaitListAdd(pont_event->OSEventWaitList, currentTask, iPriority);
   
   // Task entered suspended state, waiting for semaphore post
   #if (VERBOSE == 1)
@@ -342,21 +407,12 @@ INT8U OSSemPend (BRTOS_Sem *pont_event, INT16U time_wait)
   #endif
   
   // Remove current task from the Ready List
-  OSReadyList = OSReadyList & ~(PriorityMask[iPriority]);
+  OSReadyListRemove(currentTask, iPriority);
   
   // Set timeout overflow
   if (time_wait)
   {  
-    timeout = (INT32U)((INT32U)OSGetCount() + (INT32U)time_wait);
-    
-    if (timeout >= TICK_COUNT_OVERFLOW)
-    {
-      Task->TimeToWait = (INT16U)(timeout - TICK_COUNT_OVERFLOW);
-    }
-    else
-    {
-      Task->TimeToWait = (INT16U)timeout;
-    }
+    Task->TimeToWait = OSWakeTimeCompute(time_wait);
     
     // Put task into delay list
     IncludeTaskIntoDelayList();
@@ -385,10 +441,10 @@ INT8U OSSemPend (BRTOS_Sem *pont_event, INT16U time_wait)
       if(Task->TimeToWait == EXIT_BY_TIMEOUT)
       {
           // Test if both timeout and post have occured before arrive here
-          if ((pont_event->OSEventWaitList & PriorityMask[iPriority]))
+          if (OSWaitListTest(pont_event->OSEventWaitList, currentTask, iPriority))
           {
             // Remove the task from the queue wait list
-            pont_event->OSEventWaitList = pont_event->OSEventWaitList & ~(PriorityMask[iPriority]);
+            OSWaitListRemove(pont_event->OSEventWaitList, currentTask, iPriority);
             
             // Decreases the queue wait list counter
             pont_event->OSEventWait--;
@@ -435,9 +491,7 @@ INT8U OSSemPost(BRTOS_Sem *pont_event)
 {
   OS_SR_SAVE_VAR  
   INT8U iPriority = (INT8U)0;
-  #if (VERBOSE == 1)
   INT8U TaskSelect = 0;
-  #endif
   
   #if (ERROR_CHECK == 1)    
     // Verifies if the pointer is NULL
@@ -455,7 +509,7 @@ INT8U OSSemPost(BRTOS_Sem *pont_event)
      
   #if (ERROR_CHECK == 1)        
     // Verifies if the event is allocated
-    if(pont_event->OSEventAllocated != TRUE)
+    if(!OSObjectCreated(pont_event, OBJECT_SEM))
     {
       // Exit Critical Section
       #if (NESTING_INT == 0)
@@ -476,28 +530,28 @@ INT8U OSSemPost(BRTOS_Sem *pont_event)
       #endif
     }else{
       Update_OSTrace(0, SEMPOST);
-    }
-  #endif      
+    }      
+  #endif
   
   // See if any task is waiting for semaphore
   if (pont_event->OSEventWait != 0)
   {
     // Selects the highest priority task
-    iPriority = SAScheduler(pont_event->OSEventWaitList);    
+    iPriority = PrioListHighest(pont_event->OSEventWaitList);    
+    TaskSelect = OSWaitListTask(pont_event->OSEventWaitList, iPriority);
 
     // Remove the selected task from the semaphore wait list
-    pont_event->OSEventWaitList = pont_event->OSEventWaitList & ~(PriorityMask[iPriority]);
+    OSWaitListRemove(pont_event->OSEventWaitList, TaskSelect, iPriority);
     
     // Decreases the semaphore wait list counter
     pont_event->OSEventWait--;
     
     // Put the selected task into Ready List
     #if (VERBOSE == 1)
-    TaskSelect = PriorityVector[iPriority];
     ContextTask[TaskSelect].State = READY;
     #endif
     
-    OSReadyList = OSReadyList | (PriorityMask[iPriority]);
+    OSReadyListAdd(TaskSelect, iPriority);
     
     // If outside of an interrupt service routine, change context to the highest priority task
     // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
@@ -531,6 +585,14 @@ INT8U OSSemPost(BRTOS_Sem *pont_event)
 #else
 	pont_event->OSEventCount++;
 #endif
+    
+    #if (BRTOS_SET_EN == 1)
+    // Signals the set that holds this semaphore
+    if (OSSetSignal(pont_event->OSEventSet, pont_event) && !iNesting)
+    {
+      ChangeContext();
+    }
+    #endif
                          
     // Exit Critical Section
     #if (NESTING_INT == 0)
@@ -0,0 +1,413 @@
+/**
+* \file stream.c
+* \brief BRTOS Stream Buffer functions
+*
+* Functions to install and use single producer / single consumer stream buffers
+*
+**/
+/*********************************************************************************************************
+*                                               BRTOS
+*                                Brazilian Real-Time Operating System
+*                            Acronymous of Basic Real-Time Operating System
+*
+*
+*                                  Open Source RTOS under MIT License
+*
+*
+*
+*                                     OS Stream Buffer functions
+*
+*
+*   Revision: 1.80
+*   Date:     17/10/2026
+*
+*  The producer only writes OSStreamIn and the consumer only writes OSStreamOut.
+*  Both indexes are OS_CPU_TYPE, so they are read and written in one access and
+*  the data transfer does not need a critical section. The kernel is only used
+*  to release the waiting consumer.
+*
+*********************************************************************************************************/
+
+#include "BRTOS.h"
+
+#if (PROCESSOR == COLDFIRE_V1)
+#pragma warn_implicitconv off
+#endif
+
+#if (BRTOS_STREAM_EN == 1)
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Stream Buffer Internal Function             /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Bytes available to the consumer
+static OS_CPU_TYPE OSStreamAvailable(BRTOS_Stream *pont_event)
+{
+  OS_CPU_TYPE in  = pont_event->OSStreamIn;
+  OS_CPU_TYPE out = pont_event->OSStreamOut;
+
+  if (in >= out)
+  {
+    return (OS_CPU_TYPE)(in - out);
+  }
+
+  return (OS_CPU_TYPE)(pont_event->OSStreamSize - out + in);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Create Stream Buffer Function               /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSStreamCreate(INT8U *buffer, OS_CPU_TYPE size, OS_CPU_TYPE trigger, BRTOS_Stream **event)
+{
+  OS_SR_SAVE_VAR
+  int i=0;
+
+  BRTOS_Stream *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+     return(IRQ_PEND_ERR);                           // Can't be create by interrupt
+  }
+
+  // One byte of the buffer is always kept empty
+  if ((buffer == NULL) || (size < 2) || (trigger == 0) || (trigger >= size))
+  {
+     return(INVALID_PARAMETERS);
+  }
+
+  // Enter critical Section
+  if (currentTask)
+     OSEnterCritical();
+
+  // Verifies if there is available event control block
+  for(i=0;i<=BRTOS_MAX_STREAM;i++)
+  {
+
+    if(i >= BRTOS_MAX_STREAM)
+    {
+      // Exit critical Section
+      if (currentTask)
+         OSExitCritical();
+
+      return(NO_AVAILABLE_EVENT);
+    }
+
+    if(BRTOS_Stream_Table[i].OSEventAllocated != TRUE)
+    {
+      BRTOS_Stream_Table[i].OSEventAllocated = TRUE;
+      pont_event = &BRTOS_Stream_Table[i];
+      break;
+    }
+  }
+
+  pont_event->OSStreamBuffer  = buffer;
+  pont_event->OSStreamSize    = size;
+  pont_event->OSStreamIn      = 0;
+  pont_event->OSStreamOut     = 0;
+  pont_event->OSStreamTrigger = trigger;
+  pont_event->OSStreamLevel   = trigger;
+  pont_event->OSStreamWaiter  = 0;
+
+  *event = pont_event;
+
+  // Exit critical Section
+  if (currentTask)
+     OSExitCritical();
+
+  return(ALLOC_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Delete Stream Buffer Function               /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSStreamDelete (BRTOS_Stream **event)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_Stream *pont_event;
+
+  if (iNesting > 0) {                                // See if caller is an interrupt
+      return(IRQ_PEND_ERR);                          // Can't be delete by interrupt
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  pont_event = *event;
+  pont_event->OSEventAllocated = 0;
+  pont_event->OSStreamIn       = 0;
+  pont_event->OSStreamOut      = 0;
+  pont_event->OSStreamWaiter   = 0;
+
+  *event = NULL;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return(DELETE_EVENT_OK);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Stream Buffer Send Function (Producer)      /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+OS_CPU_TYPE OSStreamSend(BRTOS_Stream *pont_event, const INT8U *data, OS_CPU_TYPE length)
+{
+  OS_SR_SAVE_VAR
+  OS_CPU_TYPE in   = pont_event->OSStreamIn;
+  OS_CPU_TYPE next;
+  OS_CPU_TYPE sent = 0;
+  INT8U       waiter;
+
+  // Copy the data without critical section
+  while (sent < length)
+  {
+    next = (OS_CPU_TYPE)(in + 1);
+    if (next == pont_event->OSStreamSize)
+    {
+      next = 0;
+    }
+
+    // Full buffer
+    if (next == pont_event->OSStreamOut)
+    {
+      break;
+    }
+
+    pont_event->OSStreamBuffer[in] = data[sent];
+    in = next;
+    sent++;
+  }
+
+  // Publish the data to the consumer
+  pont_event->OSStreamIn = in;
+
+  // The kernel is only used when the consumer is waiting and the trigger level was reached
+  if ((pont_event->OSStreamWaiter != 0) && (OSStreamAvailable(pont_event) >= pont_event->OSStreamLevel))
+  {
+    // Enter Critical Section
+    #if (NESTING_INT == 0)
+    if (!iNesting)
+    #endif
+       OSEnterCritical();
+
+    waiter = pont_event->OSStreamWaiter;
+    if (waiter != 0)
+    {
+      pont_event->OSStreamWaiter = 0;
+
+      // Put the consumer task into Ready List
+      #if (VERBOSE == 1)
+      ContextTask[waiter].State = READY;
+      #endif
+
+      OSReadyListAdd(waiter, ContextTask[waiter].Priority);
+
+      // If outside of an interrupt service routine, change context to the highest priority task
+      // If inside of an interrupt, the interrupt itself will change the context to the highest priority task
+      if (!iNesting)
+      {
+        ChangeContext();
+      }
+    }
+
+    // Exit Critical Section
+    #if (NESTING_INT == 0)
+    if (!iNesting)
+    #endif
+       OSExitCritical();
+  }
+
+  return sent;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Stream Buffer Receive Function (Consumer)   /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSStreamReceive(BRTOS_Stream *pont_event, INT8U *data, OS_CPU_TYPE length, OS_CPU_TYPE *received, TickType time_wait)
+{
+  OS_SR_SAVE_VAR
+  INT8U  iPriority = 0;
+  OS_CPU_TYPE out;
+  OS_CPU_TYPE count = 0;
+  ContextType *Task;
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the pointer is NULL
+    if((pont_event == NULL) || (data == NULL))
+    {
+      return(NULL_EVENT_POINTER);
+    }
+
+    // Verifies if the event is allocated
+    if(pont_event->OSEventAllocated != TRUE)
+    {
+      return(ERR_EVENT_NO_CREATED);
+    }
+  #endif
+
+  // The consumer waits for the trigger level, or less if it asks for less data
+  if (OSStreamAvailable(pont_event) < pont_event->OSStreamTrigger)
+  {
+    // Can not wait inside an interrupt handler or while the scheduler is locked
+    #if (BRTOS_SCHED_LOCK_EN == 1)
+    if (!iNesting && !OSSchedLockNesting && length)
+    #else
+    if (!iNesting && length)
+    #endif
+    {
+      // Enter Critical Section
+      OSEnterCritical();
+
+      pont_event->OSStreamLevel = pont_event->OSStreamTrigger;
+      if (length < pont_event->OSStreamLevel)
+      {
+        pont_event->OSStreamLevel = length;
+      }
+
+      // The producer may have reached the level before the critical section
+      if (OSStreamAvailable(pont_event) < pont_event->OSStreamLevel)
+      {
+        Task = (ContextType*)&ContextTask[currentTask];
+
+        // Copy task priority to local scope
+        iPriority = Task->Priority;
+
+        pont_event->OSStreamWaiter = currentTask;
+
+        // Task entered suspended state, waiting for the stream data
+        #if (VERBOSE == 1)
+        Task->State = SUSPENDED;
+        Task->SuspendedType = STREAM;
+        #endif
+
+        // Remove current task from the Ready List
+        OSReadyListRemove(currentTask, iPriority);
+
+        // Set timeout overflow
+        if (time_wait)
+        {
+          Task->TimeToWait = OSWakeTimeCompute(time_wait);
+
+          // Put task into delay list
+          IncludeTaskIntoDelayList();
+        } else
+        {
+          Task->TimeToWait = NO_TIMEOUT;
+        }
+
+        // Change Context - Returns on time overflow or trigger level
+        ChangeContext();
+
+        if (time_wait)
+        {
+            // Exit Critical Section
+            OSExitCritical();
+            // Enter Critical Section
+            OSEnterCritical();
+
+            // Verify if the reason of task wake up was timeout
+            if(Task->TimeToWait == EXIT_BY_TIMEOUT)
+            {
+                // The consumer reads the data received until now
+                pont_event->OSStreamWaiter = 0;
+            }
+            else
+            {
+                // Remove the time to wait condition
+                Task->TimeToWait = NO_TIMEOUT;
+
+                // Remove from delay list
+                RemoveFromDelayList();
+            }
+        }
+      }
+
+      // Exit Critical Section
+      OSExitCritical();
+    }
+  }
+
+  // Copy the data without critical section
+  out = pont_event->OSStreamOut;
+  while ((count < length) && (out != pont_event->OSStreamIn))
+  {
+    data[count] = pont_event->OSStreamBuffer[out];
+    count++;
+
+    out++;
+    if (out == pont_event->OSStreamSize)
+    {
+      out = 0;
+    }
+  }
+
+  // Release the buffer space to the producer
+  pont_event->OSStreamOut = out;
+
+  if (received != NULL)
+  {
+    *received = count;
+  }
+
+  if ((count == 0) && length)
+  {
+    return TIMEOUT;
+  }
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#endif
@@ -134,7 +134,7 @@ static void BRTOS_TimerTaskSleep(TIMER_CNT next_time_to_wake)
     Task->SuspendedType = DELAY;
   #endif
   
-  OSReadyList = OSReadyList & ~(PriorityMask[Task->Priority]);
+  OSReadyListRemove(currentTask, Task->Priority);
   
   // Change context
   // Return to task when occur delay overflow
@@ -144,6 +144,21 @@ static void BRTOS_TimerTaskSleep(TIMER_CNT next_time_to_wake)
     
 }
 
+/* Change the wake time of the sleeping timer task */
+/* The delay list is ordered by wake time, so the task must be reinserted */
+static void BRTOS_TimerTaskWakeUpdate(TIMER_CNT next_time_to_wake)
+{
+  ContextType *Task = (ContextType*)&ContextTask[BRTOS_TIMER_VECTOR.handling_task];
+  
+  // Only if the timer task is waiting in the delay list
+  if ((Task->TimeToWait != EXIT_BY_TIMEOUT) && (Task->TimeToWait != NO_TIMEOUT))
+  {
+    RemoveFromDelayList();
+    Task->TimeToWait = next_time_to_wake;
+    IncludeTaskIntoDelayList();
+  }
+}
+
 /* Timer Task */
 void BRTOS_TimerTask(void)
 {
@@ -152,7 +167,6 @@ void BRTOS_TimerTask(void)
      BRTOS_TIMER p;
      TIMER_CNT   tickcount;
      TIMER_CNT   repeat;
-     INT32U      timeout;
      TIMER_CNT   next_time_to_wake;      /* tick count of next timer */
      BRTOS_TMR_T *list, *list_tmp;          
      
@@ -192,10 +206,10 @@ timer_loop:
                            
               if (repeat > 0)
               { /* needs to repeat after "repeat" time ? */
-                  timeout = (INT32U)((INT32U)tickcount + (INT32U)repeat);                  
-                  if (timeout >= TICK_COUNT_OVERFLOW)
+                  if (repeat > TIMER_MAX_COUNTER) repeat = TIMER_MAX_COUNTER;
+                  if (repeat >= (TIMER_CNT)(TICK_COUNT_OVERFLOW - tickcount))
                   {
-                    p->timeout = (TIMER_CNT)(timeout - TICK_COUNT_OVERFLOW);                                 
+                    p->timeout = (TIMER_CNT)(repeat - (TICK_COUNT_OVERFLOW - tickcount));                                 
                     list_tmp = BRTOS_TIMER_VECTOR.future; // add into future list
                     list_tmp->timers[++list_tmp->count] = p; // insert in the end
                     Subir(list_tmp->timers,list_tmp->count);                                      
@@ -205,7 +219,7 @@ timer_loop:
                   }
                   else
                   {
-                    p->timeout = (TIMER_CNT)timeout;                  
+                    p->timeout = (TIMER_CNT)(tickcount + repeat);
                   }                  
                } 
                else
@@ -271,7 +285,7 @@ void OSTimerInit(INT16U timertask_stacksize, INT8U prio){
   BRTOS_TimerTaskInit();
    
    
-  if(InstallTask(&BRTOS_TimerTask,"BRTOS Timers Task",timertask_stacksize, prio) != OK)
+  if(InstallTask(&BRTOS_TimerTask,"BRTOS Timers Task",timertask_stacksize, prio, NULL) != OK)
   {
     while(1){};
   }  
@@ -298,7 +312,7 @@ INT8U OSTimerSet (BRTOS_TIMER *cbp, FCN_CALLBACK cb, TIMER_CNT time_wait)
     
     INT8U i;     
     BRTOS_TIMER p;
-    INT32U timeout;
+    TIMER_CNT tickcount;
     BRTOS_TMR_T* list;
     
     if((cb == NULL) || (cbp == NULL)) return NULL_EVENT_POINTER;    /* return error code */        
@@ -342,19 +356,20 @@ INT8U OSTimerSet (BRTOS_TIMER *cbp, FCN_CALLBACK cb, TIMER_CNT time_wait)
        
     if(time_wait > 0)
     {      
+      if(time_wait > TIMER_MAX_COUNTER) time_wait = TIMER_MAX_COUNTER;
     
-      timeout = (INT32U)((INT32U)OSGetCount() + (INT32U)time_wait);
+      tickcount = OSGetCount();
       
-      if (timeout >= TICK_COUNT_OVERFLOW)
+      if (time_wait >= (TIMER_CNT)(TICK_COUNT_OVERFLOW - tickcount))
       {
-        p->timeout = (INT16U)(timeout - TICK_COUNT_OVERFLOW);
+        p->timeout = (TIMER_CNT)(time_wait - (TICK_COUNT_OVERFLOW - tickcount));
         list = BRTOS_TIMER_VECTOR.future;   // add into future list
         list->timers[++list->count] = p; // insert in the end                            
         Subir (list->timers, list->count); // order it 
       }
       else
       {
-        p->timeout = (INT16U)timeout;
+        p->timeout = (TIMER_CNT)(tickcount + time_wait);
         list = BRTOS_TIMER_VECTOR.current;  // add into current list
         list->timers[++list->count] = p; // insert in the end                            
         Subir (list->timers, list->count); // order it 
@@ -364,7 +379,7 @@ INT8U OSTimerSet (BRTOS_TIMER *cbp, FCN_CALLBACK cb, TIMER_CNT time_wait)
         {          
           if(p->timeout == (list->timers[1])->timeout)
           {
-            ContextTask[BRTOS_TIMER_VECTOR.handling_task].TimeToWait = p->timeout;
+            BRTOS_TimerTaskWakeUpdate(p->timeout);
           }
         }
                          
@@ -433,7 +448,7 @@ TIMER_CNT OSTimerGet (BRTOS_TIMER p)
 INT8U OSTimerStart (BRTOS_TIMER p, TIMER_CNT time_wait){
  
   OS_SR_SAVE_VAR
-  INT32U timeout;
+  TIMER_CNT tickcount;
   BRTOS_TMR_T* list;
   
   if(p!= NULL && time_wait != 0)
@@ -447,18 +462,18 @@ INT8U OSTimerStart (BRTOS_TIMER p, TIMER_CNT time_wait){
       if(time_wait > 0)
       {      
     
-        timeout = (INT32U)((INT32U)OSGetCount() + (INT32U)time_wait);
+        tickcount = OSGetCount();
         
-        if (timeout >= TICK_COUNT_OVERFLOW)
+        if (time_wait >= (TIMER_CNT)(TICK_COUNT_OVERFLOW - tickcount))
         {
-          p->timeout = (TIMER_CNT)(timeout - TICK_COUNT_OVERFLOW);
+          p->timeout = (TIMER_CNT)(time_wait - (TICK_COUNT_OVERFLOW - tickcount));
           list = BRTOS_TIMER_VECTOR.future;   // add into future list
           list->timers[++list->count] = p; // insert in the end                            
           Subir (list->timers, list->count); // order it 
         }
         else
         {
-          p->timeout = (TIMER_CNT)timeout;
+          p->timeout = (TIMER_CNT)(tickcount + time_wait);
           list = BRTOS_TIMER_VECTOR.current;  // add into current list
           list->timers[++list->count] = p; // insert in the end                            
           Subir (list->timers, list->count); // order it 
@@ -468,7 +483,7 @@ INT8U OSTimerStart (BRTOS_TIMER p, TIMER_CNT time_wait){
           {          
             if(p->timeout == (list->timers[1])->timeout)
             {
-              ContextTask[BRTOS_TIMER_VECTOR.handling_task].TimeToWait = p->timeout;
+              BRTOS_TimerTaskWakeUpdate(p->timeout);
             }
           }
                            
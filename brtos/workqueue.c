@@ -0,0 +1,483 @@
+/**
+* \file workqueue.c
+* \brief BRTOS Work Queue functions
+*
+* Functions to run short jobs in a pool of worker tasks
+*
+**/
+/*********************************************************************************************************
+*                                               BRTOS
+*                                Brazilian Real-Time Operating System
+*                            Acronymous of Basic Real-Time Operating System
+*
+*
+*                                  Open Source RTOS under MIT License
+*
+*
+*
+*                                      OS Work Queue functions
+*
+*
+*   Revision: 1.80
+*   Date:     17/10/2026
+*
+*  The jobs are kept in a table of BRTOS_WORK_QUEUE_SIZE entries. A counting
+*  semaphore holds the number of free entries, so the submitting task waits
+*  when the pool is full. The worker tasks take the jobs from a dynamic queue
+*  of job pointers, in submission order.
+*
+*  A delayed job stays in the table until it expires. Then the first worker
+*  that sees it puts it into the job queue. The workers wait for the queue
+*  with a timeout to the next delayed job. A new delayed job posts one NULL
+*  pointer to the queue, so a worker computes the timeout again.
+*
+*  The job queue has one entry more than the table, for that NULL pointer.
+*  Each job in the queue owns a table entry, so the queue is never full.
+*
+*********************************************************************************************************/
+
+#include "BRTOS.h"
+
+#if (PROCESSOR == COLDFIRE_V1)
+#pragma warn_implicitconv off
+#endif
+
+#if ((BRTOS_WORK_EN == 1) && (BRTOS_SEM_EN == 1) && (BRTOS_DYNAMIC_QUEUE_ENABLED == 1))
+
+/* private data */
+static BRTOS_Work   BRTOS_Work_Table[BRTOS_WORK_QUEUE_SIZE];   /* jobs */
+static BRTOS_Queue *OSWorkQueue;                               /* submitted jobs */
+static BRTOS_Sem   *OSWorkSlots;                               /* free job entries */
+static INT8U        OSWorkKick;                                /* NULL pointer in the job queue */
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Work Queue Internal Functions               /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+// Ticks since the delayed job was submitted
+static TickType OSWorkElapsed(BRTOS_Work *work, TickType now)
+{
+  if (now >= work->OSWorkStart)
+  {
+    return (TickType)(now - work->OSWorkStart);
+  }
+
+  return (TickType)(TICK_COUNT_OVERFLOW - work->OSWorkStart + now);
+}
+
+
+
+// Puts the expired delayed jobs into the job queue
+static void OSWorkPostDue(void)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_Work *work;
+  TickType    now;
+  INT8U       due;
+  INT16U      i;
+
+  for (i = 0; i < BRTOS_WORK_QUEUE_SIZE; i++)
+  {
+    work = &BRTOS_Work_Table[i];
+    due  = FALSE;
+    now  = OSGetTickCount();
+
+    // Enter Critical Section
+    OSEnterCritical();
+
+    if ((work->OSWorkState == WORK_DELAYED) && (OSWorkElapsed(work, now) >= work->OSWorkDelay))
+    {
+      work->OSWorkState = WORK_QUEUED;
+      due = TRUE;
+    }
+
+    // Exit Critical Section
+    OSExitCritical();
+
+    if (due == TRUE)
+    {
+      (void)OSDQueuePost(OSWorkQueue, &work);
+    }
+  }
+}
+
+
+
+// Ticks to the next delayed job - 0 if there is no delayed job
+static TickType OSWorkNextTimeout(void)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_Work *work;
+  TickType    now;
+  TickType    elapsed;
+  TickType    timeout = 0;
+  INT16U      i;
+
+  now = OSGetTickCount();
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  for (i = 0; i < BRTOS_WORK_QUEUE_SIZE; i++)
+  {
+    work = &BRTOS_Work_Table[i];
+
+    if (work->OSWorkState == WORK_DELAYED)
+    {
+      elapsed = OSWorkElapsed(work, now);
+
+      // An expired job is queued by the next OSWorkPostDue call
+      if (elapsed >= work->OSWorkDelay)
+      {
+        timeout = 1;
+        break;
+      }
+
+      if ((timeout == 0) || ((TickType)(work->OSWorkDelay - elapsed) < timeout))
+      {
+        timeout = (TickType)(work->OSWorkDelay - elapsed);
+      }
+    }
+  }
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  return timeout;
+}
+
+
+
+// Runs a job taken from the job queue and releases its entry
+static void OSWorkRun(BRTOS_Work *work)
+{
+  OS_SR_SAVE_VAR
+  INT8U run = FALSE;
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  // The job may have been cancelled after it was queued
+  if (work->OSWorkState == WORK_QUEUED)
+  {
+    work->OSWorkState = WORK_RUNNING;
+    run = TRUE;
+  }
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  if (run == TRUE)
+  {
+    work->OSWorkFunc(work->OSWorkArg);
+  }
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  work->OSWorkState = WORK_FREE;
+  work->OSWorkFunc  = NULL;
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  (void)OSSemPost(OSWorkSlots);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Worker Task                                 /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#if (TASK_WITH_PARAMETERS == 1)
+static void BRTOS_WorkTask(void *parameters)
+#else
+static void BRTOS_WorkTask(void)
+#endif
+{
+  OS_SR_SAVE_VAR
+  BRTOS_Work *work;
+
+  for (;;)
+  {
+    OSWorkPostDue();
+
+    if (OSDQueuePend(OSWorkQueue, &work, OSWorkNextTimeout()) == READ_BUFFER_OK)
+    {
+      if (work != NULL)
+      {
+        OSWorkRun(work);
+      }
+      else
+      {
+        // A delayed job was submitted - the timeout is computed again
+        OSEnterCritical();
+        OSWorkKick = FALSE;
+        OSExitCritical();
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Work Queue Init Function                    /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSWorkInit(const INT8U *priorities, INT8U workers, INT16U stacksize)
+{
+  INT8U  ret;
+  INT16U i;
+
+  if ((priorities == NULL) || (workers == 0))
+  {
+    return(INVALID_PARAMETERS);
+  }
+
+  for (i = 0; i < BRTOS_WORK_QUEUE_SIZE; i++)
+  {
+    BRTOS_Work_Table[i].OSWorkState = WORK_FREE;
+    BRTOS_Work_Table[i].OSWorkFunc  = NULL;
+  }
+  OSWorkKick = FALSE;
+
+  ret = OSDQueueCreate((INT16U)(BRTOS_WORK_QUEUE_SIZE + 1), (OS_CPU_TYPE)sizeof(BRTOS_Work *), &OSWorkQueue);
+  if (ret != ALLOC_EVENT_OK)
+  {
+    return ret;
+  }
+
+  ret = OSSemCreate(BRTOS_WORK_QUEUE_SIZE, &OSWorkSlots);
+  if (ret != ALLOC_EVENT_OK)
+  {
+    return ret;
+  }
+
+  for (i = 0; i < workers; i++)
+  {
+    #if (TASK_WITH_PARAMETERS == 1)
+    ret = InstallTask(&BRTOS_WorkTask, "BRTOS Worker Task", stacksize, priorities[i], NULL, NULL);
+    #else
+    ret = InstallTask(&BRTOS_WorkTask, "BRTOS Worker Task", stacksize, priorities[i], NULL);
+    #endif
+
+    if (ret != OK)
+    {
+      return ret;
+    }
+  }
+
+  return OK;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Work Submit Functions                       /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSWorkSubmitDelayed(FCN_WORK func, void *arg, TickType delay, TickType time_wait, BRTOS_Work **work)
+{
+  OS_SR_SAVE_VAR
+  BRTOS_Work *pont_work = NULL;
+  BRTOS_Work *kick = NULL;
+  TickType    now;
+  INT8U       post;
+  INT8U       ret;
+  INT16U      i;
+
+  // Can not wait for a free entry inside an interrupt handler
+  if (iNesting > 0)
+  {
+    return(IRQ_PEND_ERR);
+  }
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the function pointer is NULL
+    if(func == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Waits for a free job entry - backpressure when the pool is full
+  ret = OSSemPend(OSWorkSlots, time_wait);
+  if (ret != OK)
+  {
+    return ret;
+  }
+
+  now = OSGetTickCount();
+
+  // Enter Critical Section
+  OSEnterCritical();
+
+  // The semaphore guarantees that there is a free entry
+  for (i = 0; i < BRTOS_WORK_QUEUE_SIZE; i++)
+  {
+    if (BRTOS_Work_Table[i].OSWorkState == WORK_FREE)
+    {
+      pont_work = &BRTOS_Work_Table[i];
+      break;
+    }
+  }
+
+  pont_work->OSWorkFunc  = func;
+  pont_work->OSWorkArg   = arg;
+  pont_work->OSWorkStart = now;
+  pont_work->OSWorkDelay = delay;
+
+  if (delay)
+  {
+    pont_work->OSWorkState = WORK_DELAYED;
+
+    // Only one NULL pointer is kept in the job queue
+    post = (INT8U)(OSWorkKick == FALSE);
+    OSWorkKick = TRUE;
+  }
+  else
+  {
+    pont_work->OSWorkState = WORK_QUEUED;
+    post = TRUE;
+  }
+
+  if (work != NULL)
+  {
+    *work = pont_work;
+  }
+
+  // Exit Critical Section
+  OSExitCritical();
+
+  if (post == TRUE)
+  {
+    if (delay)
+    {
+      (void)OSDQueuePost(OSWorkQueue, &kick);
+    }
+    else
+    {
+      (void)OSDQueuePost(OSWorkQueue, &pont_work);
+    }
+  }
+
+  return OK;
+}
+
+
+
+INT8U OSWorkSubmit(FCN_WORK func, void *arg, TickType time_wait, BRTOS_Work **work)
+{
+  return OSWorkSubmitDelayed(func, arg, 0, time_wait, work);
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+
+
+
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      Work Cancel Function                        /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT8U OSWorkCancel(BRTOS_Work *work)
+{
+  OS_SR_SAVE_VAR
+  INT8U ret = OK;
+  INT8U release = FALSE;
+
+  #if (ERROR_CHECK == 1)
+    // Verifies if the pointer is NULL
+    if(work == NULL)
+    {
+      return(NULL_EVENT_POINTER);
+    }
+  #endif
+
+  // Enter Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSEnterCritical();
+
+  switch (work->OSWorkState)
+  {
+    case WORK_QUEUED:
+      // The worker that takes the job releases the entry
+      work->OSWorkState = WORK_CANCELLED;
+      break;
+
+    case WORK_DELAYED:
+      // The job is not in the job queue yet
+      work->OSWorkState = WORK_FREE;
+      work->OSWorkFunc  = NULL;
+      release = TRUE;
+      break;
+
+    default:
+      // The job is running, has already run or was cancelled
+      ret = BUSY_RESOURCE;
+      break;
+  }
+
+  // Exit Critical Section
+  #if (NESTING_INT == 0)
+  if (!iNesting)
+  #endif
+     OSExitCritical();
+
+  if (release == TRUE)
+  {
+    (void)OSSemPost(OSWorkSlots);
+  }
+
+  return ret;
+}
+
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+#endif
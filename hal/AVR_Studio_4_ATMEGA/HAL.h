@@ -17,6 +17,9 @@
 /// Define the CPU type
 #define OS_CPU_TYPE 	INT8U
 
+/// There is no CLZ instruction for AVR MCUs - byte lookup table (SCHED_LOOKUP_TABLE)
+#define OPTIMIZED_SCHEDULER 3
+
 /// Define if nesting interrupt is active
 #define NESTING_INT 1
 
@@ -67,6 +67,9 @@
 /// Define CPU Type
 #define OS_CPU_TYPE INT16U
 
+/// There is no CLZ instruction for MSP430 MCUs - byte lookup table (SCHED_LOOKUP_TABLE)
+#define OPTIMIZED_SCHEDULER 3
+
 extern INT8U iNesting;
 
 extern INT16U SPvalue;                             ///< Used to save and restore a task stack pointer
@@ -18,8 +18,8 @@
 /// Define the CPU type
 #define OS_CPU_TYPE 	INT8U
 
-/// There is no optimized scheduler for HCS08 MCUs
-#define OPTIMIZED_SCHEDULER 0
+/// There is no CLZ instruction for HCS08 MCUs - byte lookup table (SCHED_LOOKUP_TABLE)
+#define OPTIMIZED_SCHEDULER 3
 
 /// Define if nesting interrupt is active
 #define NESTING_INT 0
@@ -63,7 +63,8 @@
 #define FPU_SUPPORT			0
 
 /// Define if the optimized scheduler will be used
-#define OPTIMIZED_SCHEDULER 0
+/// Cortex-M0 has no CLZ instruction - de Bruijn multiplication (SCHED_DE_BRUIJN)
+#define OPTIMIZED_SCHEDULER 4
 
 /// Define if InstallTask function will support parameters
 #define TASK_WITH_PARAMETERS 0
@@ -62,6 +62,85 @@ void TickTimerSetup(void)
 
 
 
+#if (TICKLESS_IDLE_EN == 1)
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+/////      OS Tick Timer Sleep (Tickless Idle)         /////
+/////                                                  /////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+
+INT16U TickTimerSleep(INT16U ticks)
+{
+	INT32U 		module  = configCPU_CLOCK_HZ / (INT32U)configTICK_RATE_HZ;
+	INT32U 		reload;
+	INT32U 		remaining;
+	INT16U 		elapsed;
+
+	// The Sys Tick Timer is a 24 bits down counter
+	if ((INT32U)ticks > (0x00FFFFFFu / module))
+	{
+		ticks = (INT16U)(0x00FFFFFFu / module);
+	}
+
+	// Stop the Sys Tick Timer
+	*(NVIC_SYSTICK_CTRL) = NVIC_SYSTICK_CLK | NVIC_SYSTICK_INT;
+
+	// A tick is already pending. The sleep is aborted.
+	if (*(NVIC_INT_CTRL) & NVIC_PENDSTSET)
+	{
+		*(NVIC_SYSTICK_CTRL) = NVIC_SYSTICK_CLK | NVIC_SYSTICK_INT | NVIC_SYSTICK_ENABLE;
+		return 0;
+	}
+
+	// Rest of the current tick period plus (ticks - 1) tick periods
+	reload = *(NVIC_SYSTICK_VAL) + (module * (INT32U)(ticks - 1u));
+	if (reload == 0) reload = 1;
+
+	// The Sys Tick Timer period is LOAD + 1 cycles
+	*(NVIC_SYSTICK_LOAD) = reload - 1u;
+	*(NVIC_SYSTICK_VAL) = 0;			// Reload the counter
+	*(NVIC_SYSTICK_CTRL) = NVIC_SYSTICK_CLK | NVIC_SYSTICK_INT | NVIC_SYSTICK_ENABLE;
+
+	// Sleep until the tick timer or another interrupt
+	__asm(" DSB ");
+	__asm(" WFI ");
+	__asm(" ISB ");
+
+	// Stop the Sys Tick Timer
+	*(NVIC_SYSTICK_CTRL) = NVIC_SYSTICK_CLK | NVIC_SYSTICK_INT;
+
+	if (*(NVIC_INT_CTRL) & NVIC_PENDSTSET)
+	{
+		// The whole period has expired. The pending tick interrupt counts the last tick.
+		elapsed = (INT16U)(ticks - 1u);
+		remaining = module;
+	}
+	else
+	{
+		// Woken by another interrupt. The tick boundaries are at multiples of module.
+		remaining = *(NVIC_SYSTICK_VAL);
+		elapsed = (INT16U)((ticks - 1u) - (remaining / module));
+		remaining = remaining % module;
+		if (remaining == 0) remaining = module;
+	}
+
+	// Finish the current tick period and go back to the periodic tick
+	*(NVIC_SYSTICK_LOAD) = remaining - 1u;
+	*(NVIC_SYSTICK_VAL) = 0;
+	*(NVIC_SYSTICK_CTRL) = NVIC_SYSTICK_CLK | NVIC_SYSTICK_INT | NVIC_SYSTICK_ENABLE;
+	*(NVIC_SYSTICK_LOAD) = module - 1u;
+
+	return elapsed;
+}
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+#endif
+
+
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 /////      OS RTC Setup                                /////
@@ -69,6 +69,9 @@
 /// Define if nesting interrupt is active
 #define NESTING_INT 1
 
+/// Define if the port provides the TickTimerSleep() hook of the tickless idle mode
+#define TICK_TIMER_SLEEP 1
+
 /// Define the Reset Watchdog macro
 #define RESET_WATCHDOG()	WWDG_SetCounter(92)
 
@@ -99,6 +102,7 @@ extern INT32U SPvalue;
 /* Constants required to manipulate the NVIC PendSV */
 #define NVIC_PENDSVSET      			0x10000000         			// Value to trigger PendSV exception.
 #define NVIC_PENDSVCLR      			0x08000000         			// Value to clear PendSV exception.
+#define NVIC_PENDSTSET      			0x04000000         			// Tick timer exception is pending.
 
 // Constants required to manipulate the NVIC SysTick
 #define NVIC_SYSTICK_CLK        		0x00000004
@@ -108,6 +112,7 @@ extern INT32U SPvalue;
 // ARM Cortex-Mx registers
 #define NVIC_SYSTICK_CTRL       		( ( volatile unsigned long *) 0xe000e010 )
 #define NVIC_SYSTICK_LOAD       		( ( volatile unsigned long *) 0xe000e014 )
+#define NVIC_SYSTICK_VAL        		( ( volatile unsigned long *) 0xe000e018 )
 #define NVIC_INT_CTRL           		( ( volatile unsigned long *) 0xe000ed04 )
 #define FPU_FPCCR						( ( volatile unsigned long *) 0xE000EF34 )
 #define NVIC_SYSPRI3					( ( volatile unsigned long *) 0xe000ed20 )
@@ -188,6 +193,15 @@ void OS_CPU_SR_Restore(INT32U);
 *********************************************************************************************/
 void TickTimerSetup(void);
 
+/*****************************************************************************************//**
+* \fn INT16U TickTimerSleep(INT16U ticks)
+* \brief Stop the periodic tick and sleep up to the specified number of ticks (tickless idle)
+*  Must be called with interrupts disabled. The tick interrupt of the last tick is left pending.
+* \param ticks Number of ticks until the next timeout
+* \return Number of complete ticks suppressed while sleeping
+*********************************************************************************************/
+INT16U TickTimerSleep(INT16U ticks);
+
 /*****************************************************************************************//**
 * \fn void OSRTCSetup(void)
 * \brief Real time clock setup
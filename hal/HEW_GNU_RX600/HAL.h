@@ -52,6 +52,9 @@
 /// Define the CPU type
 #define OS_CPU_TYPE 	INT32U
 
+/// There is no CLZ instruction for RX600 MCUs - de Bruijn multiplication (SCHED_DE_BRUIJN)
+#define OPTIMIZED_SCHEDULER 4
+
 #define PSW_INIT     	0x00010000u
 
 /// Define if nesting interrupt is active
@@ -51,7 +51,8 @@
 #define OS_CPU_TYPE 	INT32U
 
 /// Define if the optimized scheduler will be used
-#define OPTIMIZED_SCHEDULER 0
+/// Cortex-M0 has no CLZ instruction - de Bruijn multiplication (SCHED_DE_BRUIJN)
+#define OPTIMIZED_SCHEDULER 4
 
 /// Define if 32 bits register for tick timer will be used
 #define TICK_TIMER_32BITS   1